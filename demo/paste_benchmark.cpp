@@ -0,0 +1,72 @@
+#include <SPSS/Graphics/TextEntryBox.h>
+#include <SPSS/System/InputSnapshot.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+//Times pasting a large clipboard string into a TextEntryBox, from the
+//CTRL+V key press up to the pasted text being laid out and drawn.
+//Usage: paste_benchmark [characters], 1 MiB by default.
+
+constexpr std::size_t DEFAULT_PASTE_SIZE{1 << 20};
+constexpr int         REPETITIONS{5};
+
+sf::Event keyPress(sf::Keyboard::Key _key) {
+    sf::Event event;
+    event.type        = sf::Event::KeyPressed;
+    event.key.code    = _key;
+    event.key.alt     = false;
+    event.key.control = true;
+    event.key.shift   = false;
+    event.key.system  = false;
+    return event;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t pasteSize{argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_PASTE_SIZE};
+
+    //The clipboard needs a window on some platforms
+    //--------------------------------------------------
+    sf::RenderWindow window{sf::VideoMode(800, 600), "SPSS Paste Benchmark"};
+    //--------------------------------------------------
+
+    //Load the font
+    //--------------------------------------------------
+    sf::Font font;
+    font.loadFromFile("demo/18thcentury.ttf");
+    //--------------------------------------------------
+
+    //Words of a few letters, so that the word index and the
+    //kerning see something like real text
+    //--------------------------------------------------
+    std::basic_string<sf::Uint32> text(pasteSize, U' ');
+    for (std::size_t i{0}; i < pasteSize; ++i) {
+        if (i % 7 != 6) {
+            text[i] = U'a' + sf::Uint32(i % 26);
+        }
+    }
+    sf::Clipboard::setString(sf::String{text});
+    //--------------------------------------------------
+
+    sf::Event control{keyPress(sf::Keyboard::LControl)};
+    sf::Event paste{keyPress(sf::Keyboard::V)};
+    spss::InputSnapshot::get_instance().handleEvent(control);
+    spss::InputSnapshot::get_instance().handleEvent(paste);
+
+    for (int i{0}; i < REPETITIONS; ++i) {
+        spss::TextEntryBox textEntryBox{400.F, {200.F, 280.F}, font};
+        textEntryBox.setMaxChars(static_cast<unsigned int>(pasteSize));
+        textEntryBox.setActive(true);
+
+        auto start{std::chrono::steady_clock::now()};
+        textEntryBox.getInput(paste);
+        window.clear();
+        window.draw(textEntryBox);
+        auto end{std::chrono::steady_clock::now()};
+
+        std::cout << "Pasted " << textEntryBox.getCurrentString().size() << " characters in "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::DialogManager owns a state's dialog prompts and toasts
+/// (short notifications that go away on their own), and takes care
+/// of their input, updating and drawing.
+///
+/// Dialogs are drawn in the order they were opened, and clicking
+/// one brings it to the front. Toasts are stacked in the top right
+/// corner of the window, above every dialog. Only so many of them
+/// are shown at once; the rest are queued and shown as the older
+/// ones expire, or are dismissed by clicking them.
+///
+/// Mouse events are only passed to the dialog or toast in front
+/// under the cursor, and keyboard events only to the dialog in
+/// front, rather than every prompt handling every event.
+///
+/// Closed prompts aren't destroyed, but kept in a pool and handed
+/// out again by the next openDialog() or showToast() call, so that
+/// showing many short-lived prompts doesn't keep on building text,
+/// shapes and text entry boxes from scratch. Closing is deferred
+/// until the end of getInput() or update(), so a button's action
+/// can safely close its own prompt, or open another one.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Graphics/DialogPrompt.h>
+#include <SPSS/System/Animator.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace spss {
+
+	class DialogManager : public spss::DrawableToWindow {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct a manager with no prompts
+		///
+		/// \param _window   The window the prompts are drawn to
+		/// \param _font     Font used to draw text
+		/// \param _charSize The prompts' character size
+		///
+		////////////////////////////////////////////////////////////
+		DialogManager(sf::RenderWindow& _window,
+		              const sf::Font&   _font,
+		              unsigned int      _charSize = 20);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Open a dialog in front of the others
+		///
+		/// The returned prompt is only valid until it's closed, and
+		/// may be handed out again afterwards.
+		///
+		/// \param _title            The prompt's title
+		/// \param _position         The position (in pixels)
+		/// \param _textEntryEnabled Whether text entry is enabled
+		///
+		/// \return The dialog, to add buttons to
+		///
+		////////////////////////////////////////////////////////////
+		DialogPrompt& openDialog(const std::string&  _title,
+		                         const sf::Vector2f& _position,
+		                         bool                _textEntryEnabled = false);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Close a dialog or toast
+		///
+		/// The prompt is returned to the pool at the end of the
+		/// current getInput() or update() call.
+		///
+		/// \param _prompt The prompt to close
+		///
+		////////////////////////////////////////////////////////////
+		void close(const DialogPrompt& _prompt);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Close every dialog and toast, and drop queued toasts
+		///
+		////////////////////////////////////////////////////////////
+		void closeAll();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Show a toast, or queue it if too many are shown
+		///
+		/// \param _message  The toast's text
+		/// \param _duration How long the toast is shown, in milliseconds
+		///
+		////////////////////////////////////////////////////////////
+		void showToast(const std::string& _message, float _duration = 3000.F);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set how many toasts can be shown at once
+		///
+		/// \param _count The amount of toasts
+		///
+		////////////////////////////////////////////////////////////
+		void setMaxToasts(size_t _count);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of open dialogs
+		///
+		////////////////////////////////////////////////////////////
+		size_t getDialogCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of toasts shown or queued
+		///
+		////////////////////////////////////////////////////////////
+		size_t getToastCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get input
+		///
+		/// \param _e A reference to a captured event
+		///
+		////////////////////////////////////////////////////////////
+		void getInput(sf::Event& _e);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Draw the dialogs, then the toasts above them
+		///
+		/// \param window Render window to draw to
+		/// \param states Current render states
+		///
+		////////////////////////////////////////////////////////////
+		void draw(sf::RenderWindow& window, sf::RenderStates states) const;
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief A toast that's being shown
+		///
+		////////////////////////////////////////////////////////////
+		struct Toast {
+			std::unique_ptr<DialogPrompt> prompt;   ///< The toast's prompt
+			Animator::Tween               lifetime; ///< Finishes once the toast expires
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief A toast waiting to be shown
+		///
+		////////////////////////////////////////////////////////////
+		struct QueuedToast {
+			std::string message;  ///< The toast's text
+			float       duration; ///< How long the toast is shown, in milliseconds
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Take a prompt from the pool, or make a new one
+		///
+		/// \param _title            The prompt's title
+		/// \param _textEntryEnabled Whether text entry is enabled
+		///
+		////////////////////////////////////////////////////////////
+		std::unique_ptr<DialogPrompt> acquire(const std::string& _title, bool _textEntryEnabled);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Return the prompts closed so far to the pool
+		///
+		////////////////////////////////////////////////////////////
+		void releaseClosed();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Show queued toasts until the maximum is reached
+		///
+		////////////////////////////////////////////////////////////
+		void showQueuedToasts();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Stack the toasts down from the top right corner
+		///
+		////////////////////////////////////////////////////////////
+		void stackToasts();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the prompt in front under the cursor
+		///
+		/// Toasts are tested before dialogs, since they're drawn
+		/// above them.
+		///
+		/// \return The prompt, or nullptr if there's none
+		///
+		////////////////////////////////////////////////////////////
+		DialogPrompt* findPromptUnderCursor() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is the prompt a toast?
+		///
+		/// \param _prompt The prompt
+		///
+		////////////////////////////////////////////////////////////
+		bool isToast(const DialogPrompt* _prompt) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Bring a dialog in front of the others
+		///
+		/// \param _prompt The dialog
+		///
+		////////////////////////////////////////////////////////////
+		void raise(const DialogPrompt* _prompt);
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		sf::RenderWindow&                          m_window;        ///< The window the prompts are drawn to
+		const sf::Font&                            m_font;          ///< Font used to draw text
+		unsigned int                               m_charSize;      ///< The prompts' character size
+		std::vector<std::unique_ptr<DialogPrompt>> m_dialogs;       ///< The open dialogs, back to front
+		std::vector<Toast>                         m_toasts;        ///< The toasts shown, top to bottom
+		std::deque<QueuedToast>                    m_queuedToasts;  ///< The toasts waiting to be shown
+		size_t                                     m_maxToasts;     ///< How many toasts can be shown at once
+		bool                                       m_stackNeeded;   ///< Do the toasts need to be stacked again after a resize?
+		std::vector<const DialogPrompt*>           m_closing;       ///< The prompts to return to the pool
+		std::vector<std::unique_ptr<DialogPrompt>> m_pool;          ///< Closed prompts without text entry
+		std::vector<std::unique_ptr<DialogPrompt>> m_textEntryPool; ///< Closed prompts with text entry
+		DialogPrompt*                              m_hovered;       ///< The prompt under the cursor
+		DialogPrompt*                              m_captured;      ///< The prompt the mouse was pressed on, until it's released
+	};
+
+} //namespace spss
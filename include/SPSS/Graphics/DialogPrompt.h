@@ -12,12 +12,18 @@
 /// Size is automatically determined and depends on the width of
 /// the title text, as well as the number of buttons. For this
 /// reason, DialogPrompt's origin is always automatically centered.
+///
+/// Layout happens in two steps: the contents are measured when they
+/// change (which also sizes the box), and then positioned relative
+/// to the box when it moves. Both are done in a single pass, so the
+/// prompt is laid out correctly as soon as it's updated, and costs
+/// nothing on the frames where nothing changes.
 ////////////////////////////////////////////////////////////////////
 
-#include <any>
-
 #include <SPSS/Graphics/DrawableToWindow.h>
 #include <SPSS/Graphics/TextEntryBox.h>
+#include <SPSS/System/Animator.h>
+#include <SPSS/System/TaskPool.h>
 #include <SPSS/Util/Function.h>
 
 namespace spss {
@@ -43,6 +49,20 @@ namespace spss {
 		             const std::string&  _boxDefaultStr = "",
 		             const unsigned int  _boxCharSize   = 20);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Reuse the prompt with a different title
+		///
+		/// Removes every button, clears the text entry box (if any),
+		/// and restores the default color and dragging behavior,
+		/// leaving the prompt as if it had just been constructed.
+		/// The completion callbacks of busy async buttons are
+		/// discarded.
+		///
+		/// \param _promptTitle The prompt title's new string
+		///
+		////////////////////////////////////////////////////////////
+		void reset(const std::string& _promptTitle);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Get input
 		///
@@ -73,7 +93,33 @@ namespace spss {
 		/// \param _action The function called upon click
 		///
 		////////////////////////////////////////////////////////////
-		void addButton(const std::string& _str, spss::Function<std::any> _action);
+		void addButton(const std::string& _str, spss::Function<> _action);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Adds a button whose action runs in the background
+		///
+		/// Clicking the button dispatches its action to
+		/// spss::TaskPool, and the button is faded and can't be
+		/// clicked again until the action returns, at which point
+		/// _onComplete is called on the main thread.
+		///
+		/// The action mustn't touch the prompt or any other widget,
+		/// which is what _onComplete is for.
+		///
+		/// \param _str        The button's text
+		/// \param _action     The function to run on a worker thread
+		/// \param _onComplete The function called once _action returns
+		///
+		////////////////////////////////////////////////////////////
+		void addAsyncButton(const std::string& _str,
+		                    spss::Function<>   _action,
+		                    spss::Function<>   _onComplete = nullptr);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is text entry enabled?
+		///
+		////////////////////////////////////////////////////////////
+		bool hasTextEntry() const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Gets the text entry box's current string
@@ -99,13 +145,13 @@ namespace spss {
 		/// \brief Get the local bounds
 		///
 		////////////////////////////////////////////////////////////
-		const sf::FloatRect& getLocalBounds() const;
+		sf::FloatRect getLocalBounds() const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Get the global bounds
 		///
 		////////////////////////////////////////////////////////////
-		const sf::FloatRect& getGlobalBounds() const;
+		sf::FloatRect getGlobalBounds() const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Get the color
@@ -146,13 +192,22 @@ namespace spss {
 		void setDraggable(bool _d);
 
 	  private:
+		//Lays out the prompts it positions right away, so they
+		//aren't drawn where they were before being pooled
+		friend class DialogManager;
+
 		////////////////////////////////////////////////////////////
 		/// This struct will represent the clickable buttons
 		///
 		struct Button {
-			sf::RectangleShape       m_shape;
-			sf::Text                 m_text;
-			spss::Function<std::any> m_action;
+			sf::RectangleShape m_shape;
+			sf::Text           m_text;
+			spss::Function<>   m_action;
+			bool               m_async{false};
+			spss::Function<>   m_onComplete;
+			TaskPool::Task     m_task;
+			bool               m_hovered{false};
+			Animator::Tween    m_hover;
 
 			void setPosition(const sf::Vector2f& _pos) {
 				m_shape.setPosition(_pos);
@@ -173,6 +228,12 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void fitWidth(float _width);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Size the prompt to the title, within the width limits
+		///
+		////////////////////////////////////////////////////////////
+		void fitTitle();
+
 		////////////////////////////////////////////////////////////
 		/// \brief Set the dialog prompt's height
 		///
@@ -210,19 +271,40 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Positions all the prompt's contents appropriately
 		///
+		/// Measures the contents if they changed, and arranges them
+		/// if they or the prompt moved.
+		///
 		////////////////////////////////////////////////////////////
 		void alignElements();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Measure the contents and size the box to fit them
+		///
+		/// The offsets of the contents from the top of the box are
+		/// cached, so arranging them doesn't have to measure any-
+		/// thing again.
+		///
+		////////////////////////////////////////////////////////////
+		void measure();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Position the contents using the cached offsets
+		///
+		////////////////////////////////////////////////////////////
+		void arrange();
+
 		mutable sf::RenderWindow*     m_window;            ///< The last window draw() is called on
 		const sf::Font&               m_font;              ///< Font used to draw text
 		sf::Text                      m_title;             ///< The dialog prompt's title text
 		sf::Vector2i                  m_lastMousePosition; ///< The last known mouse position (used to determine offset when dragging)
-		sf::Vector2f                  m_lastPosition;      ///< The last known prompt position (used to determine whether re-alignment is needed)
 		bool                          m_draggable;         ///< Whether the prompt can be dragged
 		bool                          m_dragging;          ///< Whether the prompt is being dragged
 		sf::RectangleShape            m_rect;              ///< The prompt's main rectangle shape
 		std::unique_ptr<TextEntryBox> m_textEntry;         ///< The [optional] text entry field
 		std::vector<Button>           m_buttons;           ///< The buttons
-		bool                          m_alignmentNeeded;   ///< Whether elements need to be re-aligned
+		bool                          m_measureNeeded;     ///< Whether the contents need to be measured again
+		bool                          m_arrangeNeeded;     ///< Whether the contents need to be positioned again
+		float                         m_textEntryTop;      ///< The offset of the text entry box from the top of the box
+		float                         m_buttonsTop;        ///< The offset of the first button from the top of the box
 	};
 } // namespace spss
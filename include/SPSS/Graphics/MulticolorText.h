@@ -9,6 +9,9 @@
 //Additionally, outline colours and thicknesses can be defined
 //for individual characters in the same way.
 //
+//Ranges of characters can also be given animated effects
+//(see MulticolorText::Effect), which are animated on the GPU.
+//
 //There are more detailed comments regarding my modifications
 //near the end of the file.
 //https://github.com/eggw/zemianadrezh
@@ -48,6 +51,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/String.hpp>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -74,6 +78,52 @@ namespace spss {
 			StrikeThrough = 1 << 3  ///< Strike through characters
 		};
 
+		////////////////////////////////////////////////////////////
+		/// \brief An animated effect that can be applied to a range
+		///        of characters
+		///
+		/// Effects are animated entirely by a vertex shader shared
+		/// by every MulticolorText, driven by a time uniform. The
+		/// effect slot and the character's index within its run are
+		/// packed into the integer part of each glyph's texture
+		/// coordinates when the geometry is built, so an animated
+		/// text costs no CPU work per frame.
+		///
+		/// If shaders aren't available, effects are ignored and the
+		/// text is drawn statically.
+		///
+		/// Use the static functions (wave(), pulse(), etc.) to
+		/// create effects.
+		///
+		////////////////////////////////////////////////////////////
+		struct Effect {
+			enum Type
+			{
+				None = 0,   ///< No effect
+				Wave,       ///< Characters bob up and down in a wave
+				Pulse,      ///< Characters fade in and out
+				Shake,      ///< Characters jitter randomly
+				Rainbow,    ///< Characters cycle through the hues
+				Typewriter  ///< Characters are revealed one by one
+			};
+
+			static Effect wave(float _amplitude = 4.F, float _frequency = 1.F);
+			static Effect pulse(float _depth = 0.75F, float _frequency = 1.F);
+			static Effect shake(float _amplitude = 1.5F, float _frequency = 20.F);
+			static Effect rainbow(float _frequency = 0.5F);
+			static Effect typewriter(float _charsPerSecond = 20.F);
+
+			Type  type;      ///< The effect type
+			float amplitude; ///< Offset in pixels (wave, shake), or opacity depth from 0-1 (pulse)
+			float frequency; ///< Cycles per second, or characters per second (typewriter)
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief The maximum amount of distinct effect runs per text
+		///
+		////////////////////////////////////////////////////////////
+		static constexpr std::size_t MaxEffectRuns = 8;
+
 		////////////////////////////////////////////////////////////
 		/// \brief Default constructor
 		///
@@ -122,6 +172,25 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void setString(const sf::String& string);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Replace part of the text's string
+		///
+		/// Like setString(), this clears the colors, thicknesses
+		/// and effects set for single characters. The characters
+		/// before \a position keep their geometry, and only the
+		/// rest is laid out again, so editing near the end of a
+		/// long string is cheap. Texts that had effects or colors
+		/// for single characters are laid out from the start.
+		///
+		/// \param position Index of the first character to replace
+		/// \param count    Number of characters to replace
+		/// \param string   String to insert in their place
+		///
+		/// \see setString
+		///
+		////////////////////////////////////////////////////////////
+		void replace(std::size_t position, std::size_t count, const sf::String& string);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Set the text's font
 		///
@@ -221,6 +290,49 @@ namespace spss {
 		                  size_t           _startPos = 0,
 		                  size_t           _endPos   = 0);
 		void setTransparency(int _alpha);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the fill color of characters without their own
+		///
+		/// Unlike colors set with setFillColor(), the default fill
+		/// color persists when the string is changed. By default,
+		/// it is opaque white.
+		///
+		/// \param color New default fill color
+		///
+		/// \see setFillColor
+		///
+		////////////////////////////////////////////////////////////
+		void setDefaultFillColor(const sf::Color& color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the outline color of characters without their own
+		///
+		/// Unlike colors set with setOutlineColor(), the default
+		/// outline color persists when the string is changed. By
+		/// default, it is opaque black.
+		///
+		/// \param color New default outline color
+		///
+		/// \see setOutlineColor
+		///
+		////////////////////////////////////////////////////////////
+		void setDefaultOutlineColor(const sf::Color& color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the outline thickness of characters without their own
+		///
+		/// Unlike thicknesses set with setOutlineThickness(), the
+		/// default thickness persists when the string is changed and
+		/// doesn't need to be stored per character, which keeps
+		/// long strings cheap. By default, it is 0.
+		///
+		/// \param thickness New default outline thickness
+		///
+		/// \see setOutlineThickness
+		///
+		////////////////////////////////////////////////////////////
+		void setDefaultOutlineThickness(float thickness);
 		void setStyleFillColor(const sf::Color& color);
 		void setStyleOutlineColor(const sf::Color& color);
 
@@ -255,6 +367,49 @@ namespace spss {
 		                         size_t _startPos = 0,
 		                         size_t _endPos   = 0);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Apply an animated effect to a range of characters
+		///
+		/// Every call creates a new effect run, whose animation
+		/// starts at the time of the call. Up to MaxEffectRuns runs
+		/// can exist at once; further calls are ignored until
+		/// clearEffects() is called. Passing an effect of type None
+		/// removes effects from the given range.
+		///
+		/// Runs longer than 2048 characters wrap around, i.e. their
+		/// characters are animated as if the run restarted.
+		///
+		/// \param effect    The effect
+		/// \param _startPos The first character of the run
+		/// \param _endPos   The last character of the run (0 = end of string)
+		///
+		/// \see clearEffects
+		///
+		////////////////////////////////////////////////////////////
+		void setEffect(const Effect& effect,
+		               size_t        _startPos = 0,
+		               size_t        _endPos   = 0);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Remove all effects
+		///
+		/// \see setEffect
+		///
+		////////////////////////////////////////////////////////////
+		void clearEffects();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Destroy the shader that animates effects
+		///
+		/// The shader is shared by every text and created the first
+		/// time one with effects is drawn. It has to be destroyed
+		/// while the window's OpenGL context still exists, so call
+		/// this before closing the window; spss::Core does so when
+		/// it exits. Texts drawn afterwards load it again.
+		///
+		////////////////////////////////////////////////////////////
+		static void releaseEffectShader();
+
 		////////////////////////////////////////////////////////////
 		/// \brief Get the text's string
 		///
@@ -376,6 +531,27 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		sf::Vector2f findCharacterPos(std::size_t index) const;
 
+		////////////////////////////////////////////////////////////
+		/// \brief Compute the positions of all characters at once
+		///
+		/// Fills \a positions with the position of every character,
+		/// plus the position of the end of the string, in a single
+		/// pass. Unlike findCharacterPos, the positions are in local
+		/// coordinates, so that they stay valid when the text is
+		/// moved; use getTransform() to convert them.
+		///
+		/// If only the characters from \a first onwards changed
+		/// since \a positions was last filled, the positions before
+		/// it are kept, and only the rest are computed again.
+		///
+		/// \param positions Vector to fill with the positions
+		/// \param first     Index of the first position to compute
+		///
+		/// \see findCharacterPos
+		///
+		////////////////////////////////////////////////////////////
+		void findCharacterPositions(std::vector<sf::Vector2f>& positions, std::size_t first = 0) const;
+
 		////////////////////////////////////////////////////////////
 		/// \brief Get the local bounding rectangle of the entity
 		///
@@ -423,6 +599,36 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void ensureGeometryUpdate() const;
 
+		////////////////////////////////////////////////////////////
+		/// \brief An effect run
+		///
+		/// Holds the effect, the index of the run's first character
+		/// (used to compute a character's index within the run), and
+		/// the time at which the run was created.
+		///
+		////////////////////////////////////////////////////////////
+		struct EffectRun {
+			Effect effect;
+			size_t startPos;
+			float  startTime;
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief The state of the layout before a character
+		///
+		/// Laying out the geometry again from a character starts
+		/// from its state, instead of from the start of the string.
+		///
+		////////////////////////////////////////////////////////////
+		struct LayoutState {
+			sf::Vector2f pen;                ///< The position the character is placed at, before kerning
+			sf::Uint32   prevChar;           ///< The previous character, for kerning
+			sf::Vector2f minBounds;          ///< The minimum coordinates of the characters before it
+			sf::Vector2f maxBounds;          ///< The maximum coordinates of the characters before it
+			std::size_t  vertexCount;        ///< The amount of fill vertices before it
+			std::size_t  outlineVertexCount; ///< The amount of outline vertices before it
+		};
+
 		///////////////////////////////////////////////////////////
 		//Data members --------------------------------------------
 		///////////////////////////////////////////////////////////
@@ -434,11 +640,17 @@ namespace spss {
 		sf::Uint32              m_style;                 ///< Text style (see Style enum)
 		sf::Color               m_styleFillColor;        ///< Strikethrough/underline color
 		sf::Color               m_styleOutlineColor;     ///< Outline color for strikethroughs/underlines
+		sf::Color               m_defaultFillColor;      ///< Fill color of characters without one in m_fillColors
+		sf::Color               m_defaultOutlineColor;   ///< Outline color of characters without one in m_outlineColors
+		float                   m_defaultOutlineThickness; ///< Outline thickness of characters without one in m_outlineThicknesses
 		float                   m_styleOutlineThickness; ///< Thickness of the text's outline
 		mutable sf::VertexArray m_vertices;              ///< Vertex array containing the fill geometry
 		mutable sf::VertexArray m_outlineVertices;       ///< Vertex array containing the outline geometry
 		mutable sf::FloatRect   m_bounds;                ///< Bounding rectangle of the text (in local coordinates)
 		mutable bool            m_geometryNeedUpdate;    ///< Does the geometry need to be recomputed?
+		mutable std::size_t     m_layoutStart;           ///< The first character to lay out again, if only part of the string changed
+
+		mutable std::vector<LayoutState> m_layoutStates; ///< The layout state before every character laid out
 
 		////////////////////////////////////////////////////////////
 		///
@@ -453,11 +665,6 @@ namespace spss {
 		/// ->m_styleOutlineColor and m_outlineThickness->
 		/// m_styleOutlineThickness.
 		///
-		/// m_vertexIndeces is a map that has the position
-		///of a character in the string as its first element,
-		/// and the index of the first of 6 vertices used to draw
-		/// it in m_vertices.
-		///
 		/// I also added setTransparency() and removed the deprecated
 		/// setColor().
 		///
@@ -466,7 +673,20 @@ namespace spss {
 		mutable std::map<int, sf::Color> m_fillColors;
 		mutable std::map<int, sf::Color> m_outlineColors;
 		mutable std::map<int, float>     m_outlineThicknesses;
-		mutable std::map<int, int>       m_vertexIndeces;
+
+		////////////////////////////////////////////////////////////
+		///
+		/// m_effects maps a character's position to its effect run
+		/// (1-based index into m_effectRuns). Since the packed texture
+		/// coordinates are relative to the size of the font's texture,
+		/// which grows as new glyphs are loaded, m_effectTextureSize
+		/// holds the size they were packed for.
+		///
+		////////////////////////////////////////////////////////////
+
+		std::map<int, int>       m_effects;
+		std::vector<EffectRun>   m_effectRuns;
+		mutable sf::Vector2u     m_effectTextureSize;
 	};
 
 } //namespace spss
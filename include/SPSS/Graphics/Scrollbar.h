@@ -5,9 +5,25 @@
 /// llbar. It will automatically size its inner section as needed,
 /// according to the ratio of visible : total content, and will re-
 /// center the associated view according to its position.
+///
+/// Mouse wheel input doesn't move the view right away: the wheel
+/// deltas received between two updates are added up and turned into
+/// a velocity, which friction slows back down, and the view eases
+/// towards where that velocity takes it. Both are measured in real
+/// time, so scrolling feels the same however often update() is
+/// called. Dragging the scrollbar, or calling scrollTo() and the
+/// snapping functions, still moves the view immediately.
+///
+/// Every update, the scrollbar tells its owner which part of the
+/// content is visible and how fast it's moving, so that only that
+/// part needs to be laid out and drawn. It can also ask the owner
+/// to prepare the content just ahead of the visible part (loading
+/// the next page of a list on a worker thread, for instance), so
+/// that it's ready by the time it scrolls into view.
 ////////////////////////////////////////////////////////////////////
 
 #include <SPSS/Graphics/DrawableToWindow.h>
+#include <SPSS/Util/Function.h>
 #include <SFML/Graphics.hpp>
 
 namespace spss {
@@ -58,6 +74,10 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Reset the scrollbar's init parameters
 		///
+		/// The scrollbar keeps its position within the new range
+		/// (or snaps to the bottom, if anchored), and the view is
+		/// moved to match it.
+		///
 		/// \param _size       The size (in pixels)
 		/// \param _pos        The position (in pixels)
 		/// \param _min        The min Y value for the scrollview's center
@@ -101,6 +121,9 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Update
 		///
+		/// Applies the wheel input received since the last update
+		/// and moves the view along.
+		///
 		////////////////////////////////////////////////////////////
 		void update();
 
@@ -153,6 +176,71 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void snapToBottom();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Scroll so that the view is centered on _centerY
+		///
+		/// The value is clamped to the min/max range. Useful for
+		/// keeping something (such as a caret) in view.
+		///
+		/// \param _centerY The desired Y value for the view's center
+		///
+		////////////////////////////////////////////////////////////
+		void scrollTo(float _centerY);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the function called when the visible range changes
+		///
+		/// The function is called from update(), with the top and
+		/// bottom of the visible range in the scroll view's coord-
+		/// inates, and the speed at which it's moving in pixels per
+		/// millisecond (negative when scrolling up). It's called
+		/// whenever any of those change, even if the scrollbar is
+		/// inactive.
+		///
+		/// \param _callback The function, or nullptr
+		///
+		////////////////////////////////////////////////////////////
+		void setVisibleRangeCallback(Function<float, float, float> _callback);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the function asked to prepare upcoming content
+		///
+		/// The function is called from update(), with the top and
+		/// bottom of a range just past the visible one, in the dir-
+		/// ection it's scrolling in (both directions while still).
+		/// Everything requested so far counts as prepared, and more
+		/// is only asked for once the view has scrolled halfway
+		/// into it, until the next reset() discards it all.
+		///
+		/// The range isn't limited to the scrollable range, so that
+		/// a list can load more entries once it's near its end.
+		///
+		/// \param _distance How far past the visible range to prepare, in pixels
+		/// \param _callback The function, or nullptr
+		///
+		////////////////////////////////////////////////////////////
+		void setPrefetchCallback(float _distance, Function<float, float> _callback);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the top of the visible range, as of the last update
+		///
+		////////////////////////////////////////////////////////////
+		float getVisibleTop() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the bottom of the visible range, as of the last update
+		///
+		////////////////////////////////////////////////////////////
+		float getVisibleBottom() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the speed of the view, in pixels per millisecond
+		///
+		/// Negative when scrolling up.
+		///
+		////////////////////////////////////////////////////////////
+		float getScrollVelocity() const;
+
 	  private:
 		////////////////////////////////////////////////////////////
 		/// \brief Is the scrollbar at the uppermost possible position?
@@ -173,12 +261,20 @@ namespace spss {
 		bool mousedOver() const;
 
 		////////////////////////////////////////////////////////////
-		/// \brief Scroll up or down a notch
+		/// \brief Move the view along with the wheel input
 		///
-		/// \param _up Up or down?
+		/// \param _elapsed The time since the last update, in milliseconds
 		///
 		////////////////////////////////////////////////////////////
-		void scroll(bool _up);
+		void glide(float _elapsed);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Stop the view where the scrollbar currently is
+		///
+		/// Discards whatever velocity the mouse wheel has built up.
+		///
+		////////////////////////////////////////////////////////////
+		void stopGliding();
 
 		////////////////////////////////////////////////////////////
 		/// \brief Move the scrollbar if it's being dragged
@@ -192,21 +288,56 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void calculateNewViewCenter();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Get the view center Y matching the scrollbar's position
+		///
+		////////////////////////////////////////////////////////////
+		float getThumbCenterY() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Position the scrollbar to match a view center Y
+		///
+		/// \param _centerY The view center Y, clamped to the min/max range
+		///
+		////////////////////////////////////////////////////////////
+		void placeThumb(float _centerY);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Tell the owner what's visible, and what to prepare
+		///
+		/// \param _elapsed The time since the last update, in milliseconds
+		///
+		////////////////////////////////////////////////////////////
+		void publishVisibleRange(float _elapsed);
+
 		///////////////////////////////////////////////////////////
 		//Data members --------------------------------------------
 		///////////////////////////////////////////////////////////
-		mutable sf::RenderWindow* m_window;          ///< The window to draw the scrollbar in
-		const sf::View&           m_backgroundView;  ///< The background view to which the scrollbar will be drawn
-		sf::View&                 m_scrollView;      ///< The view to which the scrollbar applies
-		sf::Color                 m_color;           ///< The color of the scrollbar
-		bool                      m_scrollWithWheel; ///< Can it be scrolled with the mouse wheel?
-		bool                      m_active;          ///< Is the scrollbar active?
-		mutable bool              m_dragging;        ///< Is the scrollbar being dragged?
-		sf::RectangleShape        m_outer;           ///< The outer part of the scrollbar
-		sf::RectangleShape        m_inner;           ///< The inner part of the scrollbar
-		float                     m_minCenterY;      ///< The minimum value for the scrollable view's center Y
-		float                     m_maxCenterY;      ///< The maximum value for the scrollable view's center Y
-		Anchor                    m_anchor;          ///< The anchor type (see enum declaration for details)
+		mutable sf::RenderWindow*     m_window;               ///< The window to draw the scrollbar in
+		const sf::View&               m_backgroundView;       ///< The background view to which the scrollbar will be drawn
+		sf::View&                     m_scrollView;           ///< The view to which the scrollbar applies
+		sf::Color                     m_color;                ///< The color of the scrollbar
+		bool                          m_scrollWithWheel;      ///< Can it be scrolled with the mouse wheel?
+		bool                          m_active;               ///< Is the scrollbar active?
+		mutable bool                  m_dragging;             ///< Is the scrollbar being dragged?
+		sf::RectangleShape            m_outer;                ///< The outer part of the scrollbar
+		sf::RectangleShape            m_inner;                ///< The inner part of the scrollbar
+		float                         m_minCenterY;           ///< The minimum value for the scrollable view's center Y
+		float                         m_maxCenterY;           ///< The maximum value for the scrollable view's center Y
+		Anchor                        m_anchor;               ///< The anchor type (see enum declaration for details)
+		float                         m_centerY;              ///< The view center Y being displayed
+		float                         m_targetCenterY;        ///< The view center Y the view is easing towards
+		float                         m_velocity;             ///< The speed of m_targetCenterY, in pixels per millisecond
+		float                         m_pendingWheel;         ///< The wheel delta received since the last update
+		sf::Clock                     m_clock;                ///< Measures the time between updates
+		float                         m_visibleTop;           ///< The top of the visible range, as of the last update
+		float                         m_visibleBottom;        ///< The bottom of the visible range, as of the last update
+		float                         m_viewVelocity;         ///< The speed of the view, in pixels per millisecond
+		Function<float, float, float> m_onVisibleRangeChange; ///< Called when the visible range or its speed change
+		Function<float, float>        m_onPrefetch;           ///< Asked to prepare the content past the visible range
+		float                         m_prefetchDistance;     ///< How far past the visible range to prepare
+		float                         m_prefetchedTop;        ///< The top of the content requested so far
+		float                         m_prefetchedBottom;     ///< The bottom of the content requested so far
 	};
 
 } // namespace spss
@@ -11,12 +11,27 @@
 /// values has a string associated with it so that the user can see
 /// what they're selecting (see SliderPair further below).
 ///
+/// Numeric sliders with many values (a volume from 0 to 100, a
+/// timeline, ...) can instead be given a range, defined by its min,
+/// max and step. No options are stored then, and only the selected
+/// value's label is formatted, whenever the selection changes.
+///
 ////////////////////////////////////////////////////////////////////
 
 #include <SPSS/Graphics/DrawableToWindow.h>
+#include <SPSS/System/InputSnapshot.h>
 #include <SFML/Graphics.hpp>
+#include <SPSS/Util/Function.h>
 #include <SPSS/Util/Input.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 namespace spss {
 
 	template<class ValueType>
@@ -39,7 +54,11 @@ namespace spss {
 		              m_outer{},
 		              m_inner{},
 		              m_options{},
-		              m_selected{0} {
+		              m_selected{0},
+		              m_range{},
+		              m_formatter{nullptr},
+		              m_label{},
+		              m_labelIndex{NO_INDEX} {
 			auto textBounds{m_title.getGlobalBounds()};
 			m_title.setOrigin(textBounds.left, textBounds.top);
 
@@ -190,15 +209,18 @@ namespace spss {
 		inline void addValue(const ValueType&   _val,
 		                     const std::string& _str,
 		                     bool               _select = false) {
+			//Adding a value leaves range mode
+			if (m_range) {
+				m_range.reset();
+				m_selected   = 0;
+				m_labelIndex = NO_INDEX;
+			}
+
 			m_options.push_back({_val, _str});
 
 			//After adding a new value, the size of the inner bar
 			//will have to be modified.
-			const float width{m_outer.getSize().x};
-
-			sf::Vector2f newSize{m_inner.getSize()};
-			newSize.x = width / m_options.size();
-			m_inner.setSize(newSize);
+			resizeInner();
 
 			//Say we call something like this:
 			//addValue(1, "1");
@@ -226,6 +248,10 @@ namespace spss {
 		///
 		////////////////////////////////////////////////////////////
 		inline const ValueType* getSelected() const {
+			if (m_range) {
+				return &m_range->value;
+			}
+
 			if (m_options.empty()) {
 				return nullptr;
 			}
@@ -233,6 +259,63 @@ namespace spss {
 			return &m_options[m_selected].m_value;
 		}
 
+		////////////////////////////////////////////////////////////
+		/// \brief Make the slider select from a range of numbers
+		///
+		/// The values go from _min to _max in increments of _step
+		/// (_max is left out if it isn't a whole amount of steps
+		/// away from _min, give or take rounding errors, like with
+		/// 0 to 1 in steps of 0.1). Any options added with addValue() are
+		/// removed, and adding one afterwards leaves range mode.
+		///
+		/// \param _min      The lowest value
+		/// \param _max      The highest value
+		/// \param _step     The difference between two consecutive values
+		/// \param _selected The value selected by default, rounded to the closest step
+		///
+		////////////////////////////////////////////////////////////
+		inline void setRange(const ValueType& _min,
+		                     const ValueType& _max,
+		                     const ValueType& _step,
+		                     const ValueType& _selected) {
+			static_assert(std::is_arithmetic_v<ValueType>, "Only numeric sliders can have a range");
+
+			size_t count{1};
+			if (_step > 0 && _max > _min) {
+				//Floating-point steps rarely divide the range exactly,
+				//so a quotient that's just shy of a whole number of
+				//steps is taken as that number
+				double steps{double(_max - _min) / double(_step)};
+				double rounded{std::round(steps)};
+				if (std::fabs(steps - rounded) <= STEP_TOLERANCE * std::max(rounded, 1.0)) {
+					steps = rounded;
+				}
+				count += size_t(std::floor(steps));
+			}
+
+			m_options.clear();
+			m_range.emplace(SliderRange{_min, _max, _step, count, _min});
+			m_labelIndex = NO_INDEX;
+
+			resizeInner();
+			select(indexOf(_selected));
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the function that formats the range's labels
+		///
+		/// The function appends the label of the given value to the
+		/// given string. By default, the value is simply printed.
+		///
+		/// \param _formatter The function, or nullptr for the default
+		///
+		////////////////////////////////////////////////////////////
+		inline void setLabelFormatter(Function<std::string&, const ValueType&> _formatter) {
+			m_formatter  = std::move(_formatter);
+			m_labelIndex = NO_INDEX;
+			select(m_selected);
+		}
+
 	  private:
 		////////////////////////////////////////////////////////////
 		/// \brief Is the slider being moused over?
@@ -245,8 +328,7 @@ namespace spss {
 
 			auto& backgroundView{m_window->getView()};
 
-			sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-			sf::Vector2f pixelPos{m_window->mapPixelToCoords(mousePos, backgroundView)};
+			sf::Vector2f pixelPos{InputSnapshot::get_instance().getMousePosition(*m_window, backgroundView)};
 
 			if (m_outer.getGlobalBounds().contains(pixelPos.x, pixelPos.y)) {
 				return true;
@@ -266,8 +348,7 @@ namespace spss {
 
 			auto& backgroundView{m_window->getView()};
 
-			auto pos{sf::Mouse::getPosition(*m_window)};
-			auto mousePos{m_window->mapPixelToCoords(pos, backgroundView)};
+			auto mousePos{InputSnapshot::get_instance().getMousePosition(*m_window, backgroundView)};
 
 			//Just some aliases for readability
 			auto outerBounds{m_outer.getGlobalBounds()};
@@ -288,58 +369,124 @@ namespace spss {
 			}
 
 			//Now that we have the slider's "true" position, we'll compare it
-			//to the number of steps (i.e. elements in m_options) and snap it
+			//to the number of steps (i.e. the amount of options) and snap it
 			//into the appropriate position.
+			size_t index{0};
+			if (upperLimit > lowerLimit) {
+				index = size_t((innerPos.x - lowerLimit) / (upperLimit - lowerLimit) * (getOptionCount() - 1));
+			}
 
-			int index{(int(innerPos.x) - int(lowerLimit)) / getStepValue()};
+			select(index);
+		}
 
-			select(size_t(index));
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of selectable values
+		///
+		////////////////////////////////////////////////////////////
+		inline size_t getOptionCount() const {
+			return m_range ? m_range->count : m_options.size();
 		}
 
 		////////////////////////////////////////////////////////////
-		/// \brief Get the step value
+		/// \brief Size the inner bar according to the amount of values
 		///
-		/// The step value is the outer bar's total width divided by
-		/// the number of selection options we have. It represents
-		/// the distance the inner bar travels from one selection
-		/// to another. For example, if our slider has a width of 100
-		/// and 2 selection options, this will return 50.
+		/// The inner bar is the outer bar's width divided by the
+		/// amount of values, but never thinner than MIN_INNER_WIDTH
+		/// so that ranges with thousands of values can still be
+		/// grabbed.
 		///
 		////////////////////////////////////////////////////////////
-		inline int getStepValue() const {
+		inline void resizeInner() {
 			const float width{m_outer.getSize().x};
 
-			//If there are no options, we'll return the width of the
-			//slider to avoid dividing by zero
-			int vectorSize{1};
-			if (m_options.size() > 1) {
-				vectorSize = int(m_options.size());
+			sf::Vector2f newSize{m_inner.getSize()};
+			newSize.x = std::min(width, std::max(width / std::max(getOptionCount(), size_t(1)), MIN_INNER_WIDTH));
+			m_inner.setSize(newSize);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the index of the range value closest to a value
+		///
+		////////////////////////////////////////////////////////////
+		inline size_t indexOf(const ValueType& _value) const {
+			if (!m_range || !(m_range->step > 0) || _value <= m_range->min) {
+				return 0;
 			}
 
-			return {int(width) / vectorSize};
+			double steps{std::round(double(_value - m_range->min) / double(m_range->step))};
+			return std::min(size_t(steps), m_range->count - 1);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Append the label of a range value to a string
+		///
+		////////////////////////////////////////////////////////////
+		inline void formatValue(std::string& _buffer, const ValueType& _value) const {
+			if (m_formatter != nullptr) {
+				m_formatter(_buffer, _value);
+				return;
+			}
+
+			char digits[32];
+			int  length{0};
+			if constexpr (std::is_integral_v<ValueType>) {
+				length = std::snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(_value));
+			}
+			else {
+				length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(_value));
+			}
+			_buffer.append(digits, size_t(std::max(length, 0)));
 		}
 
 		////////////////////////////////////////////////////////////
 		/// \brief Selects the option at the given index
 		///
 		/// Handles not only snapping the inner bar into the approp-
-		/// riate position, but also updating the title text.
+		/// riate position, but also updating the title text. The
+		/// title is only rebuilt if the index actually changed, so
+		/// dragging within the same option doesn't touch it.
 		///
 		/// \param _i The desired index to select
 		///
 		////////////////////////////////////////////////////////////
 		inline void select(size_t _i) {
-			m_selected = _i;
+			const size_t count{getOptionCount()};
+			m_selected = std::min(_i, count > 0 ? count - 1 : 0);
+
+			const float width{m_outer.getSize().x - m_inner.getSize().x};
 
 			auto outerPos{m_outer.getPosition()};
 			auto innerPos{m_inner.getPosition()};
 
-			innerPos.x = outerPos.x + (getStepValue() * int(m_selected));
+			innerPos.x = outerPos.x;
+			if (count > 1) {
+				innerPos.x += width * float(m_selected) / float(count - 1);
+			}
 			m_inner.setPosition(innerPos);
 
-			if (m_options.size() >= 1) {
-				m_title.setString(m_titleStr + " " + m_options[m_selected].m_str);
+			if (count == 0 || m_selected == m_labelIndex) {
+				return;
 			}
+
+			//The label is built in the same buffer every time
+			m_label.assign(m_titleStr);
+			m_label += ' ';
+
+			//Only numeric sliders can be in range mode
+			if constexpr (std::is_arithmetic_v<ValueType>) {
+				if (m_range) {
+					//The last value may overshoot _max by a rounding error
+					m_range->value = std::min(ValueType(m_range->min + m_range->step * ValueType(m_selected)), m_range->max);
+					formatValue(m_label, m_range->value);
+				}
+			}
+
+			if (!m_range) {
+				m_label += m_options[m_selected].m_str;
+			}
+
+			m_title.setString(m_label);
+			m_labelIndex = m_selected;
 		}
 
 		//A simple struct we'll use to represent slider selection options.
@@ -351,18 +498,35 @@ namespace spss {
 			std::string m_str;   ///< The associated string
 		};
 
+		//The values of a slider in range mode
+		struct SliderRange {
+			ValueType min;   ///< The lowest value
+			ValueType max;   ///< The highest value
+			ValueType step;  ///< The difference between two consecutive values
+			size_t    count; ///< The amount of values
+			ValueType value; ///< The selected value
+		};
+
+		static constexpr size_t NO_INDEX{size_t(-1)};
+		static constexpr float  MIN_INNER_WIDTH{6.F};
+		static constexpr double STEP_TOLERANCE{1e-6};
+
 		///////////////////////////////////////////////////////////
 		//Data members --------------------------------------------
 		///////////////////////////////////////////////////////////
-		mutable sf::RenderWindow* m_window;   ///< The window to draw the slider in
-		sf::Color                 m_color;    ///< The color of the slider
-		mutable bool              m_dragging; ///< Is the slider being dragged?
-		std::string               m_titleStr; ///< The original slider title text string
-		sf::Text                  m_title;    ///< The slider's title text
-		sf::RectangleShape        m_outer;    ///< The outer part of the slider
-		sf::RectangleShape        m_inner;    ///< The inner part of the slider
-		size_t                    m_selected; ///< The index (of m_options) that's currently selected
-		std::vector<SliderPair>   m_options;  ///< The vector that stores all the SliderPairs
+		mutable sf::RenderWindow*                m_window;     ///< The window to draw the slider in
+		sf::Color                                m_color;      ///< The color of the slider
+		mutable bool                             m_dragging;   ///< Is the slider being dragged?
+		std::string                              m_titleStr;   ///< The original slider title text string
+		sf::Text                                 m_title;      ///< The slider's title text
+		sf::RectangleShape                       m_outer;      ///< The outer part of the slider
+		sf::RectangleShape                       m_inner;      ///< The inner part of the slider
+		size_t                                   m_selected;   ///< The index (of m_options) that's currently selected
+		std::vector<SliderPair>                  m_options;    ///< The vector that stores all the SliderPairs
+		std::optional<SliderRange>               m_range;      ///< The range of values, if in range mode
+		Function<std::string&, const ValueType&> m_formatter;  ///< Appends a range value's label to a string, if set
+		std::string                              m_label;      ///< The title text's string, reused whenever the selection changes
+		size_t                                   m_labelIndex; ///< The index the title text was last built for, or NO_INDEX
 	};
 
 } // namespace spss
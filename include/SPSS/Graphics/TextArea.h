@@ -0,0 +1,415 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::TextArea is a multi-line text editor, useful for things
+/// like notes and script snippets.
+///
+/// It supports the same selection model as spss::TextEntryBox
+/// (SHIFT + arrow keys, CTRL+A, clicking and dragging) along with
+/// copying, cutting and pasting, and scrolls vertically with an
+/// spss::Scrollbar.
+///
+/// The text is stored as a GapBuffer of lines, each of which caches
+/// its own layout (the positions of its characters). Edits only
+/// invalidate the lines they touch, and only the visible lines are
+/// bound to spss::MulticolorText objects and drawn, so the cost of
+/// typing doesn't depend on the length of the document.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Graphics/DrawableToWindow.h>
+#include <SPSS/Graphics/MulticolorText.h>
+#include <SPSS/Graphics/Scrollbar.h>
+#include <SPSS/Util/GapBuffer.h>
+#include <SFML/Graphics.hpp>
+
+#include <string>
+#include <vector>
+
+namespace spss {
+
+	class TextArea : public spss::DrawableToWindow {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct the text area
+		///
+		/// \param _size     The size of the area, including the scrollbar
+		/// \param _position The position of the area
+		/// \param _font     Font used to draw text
+		/// \param _charSize The character size
+		/// \param _str      The default string value, encoded in UTF-8
+		///
+		////////////////////////////////////////////////////////////
+		TextArea(const sf::Vector2f& _size,
+		         const sf::Vector2f& _position,
+		         const sf::Font&     _font,
+		         const unsigned int  _charSize = 20,
+		         const std::string&  _str      = "");
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the position of the text area
+		///
+		/// \param _position The new position
+		///
+		////////////////////////////////////////////////////////////
+		void setPosition(const sf::Vector2f& _position);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the position of the text area
+		///
+		////////////////////////////////////////////////////////////
+		const sf::Vector2f& getPosition() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the size of the text area
+		///
+		/// \param _size The new size, including the scrollbar
+		///
+		////////////////////////////////////////////////////////////
+		void setSize(const sf::Vector2f& _size);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the size of the text area
+		///
+		////////////////////////////////////////////////////////////
+		const sf::Vector2f& getSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the global bounds of the text area
+		///
+		////////////////////////////////////////////////////////////
+		const sf::FloatRect getGlobalBounds() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the background color
+		///
+		/// \param _color The color
+		///
+		////////////////////////////////////////////////////////////
+		void setColor(const sf::Color& _color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the text's fill color
+		///
+		/// \param _color The color
+		///
+		////////////////////////////////////////////////////////////
+		void setTextFillColor(const sf::Color& _color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the caret's color
+		///
+		/// \param _color The color
+		///
+		////////////////////////////////////////////////////////////
+		void setCaretColor(const sf::Color& _color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the scrollbar's color
+		///
+		/// \param _color The color
+		///
+		////////////////////////////////////////////////////////////
+		void setScrollbarColor(const sf::Color& _color);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Replace the contents of the text area
+		///
+		/// \param _str The new contents, encoded in UTF-8
+		///
+		////////////////////////////////////////////////////////////
+		void setString(const std::string& _str);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the contents of the text area
+		///
+		/// Lines are separated by '\n', and the contents are encoded
+		/// in UTF-8.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string getString() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of lines
+		///
+		////////////////////////////////////////////////////////////
+		size_t getLineCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Toggles whether the text area is active
+		///
+		/// When set to true, the text area will accept keyboard
+		/// input. Clicking inside or outside of the text area also
+		/// activates or deactivates it.
+		///
+		/// \param _b The boolean value
+		///
+		////////////////////////////////////////////////////////////
+		void setActive(bool _b);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is text being entered?
+		///
+		////////////////////////////////////////////////////////////
+		bool enteringText() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get input
+		///
+		/// \param _event A reference to a captured event
+		///
+		////////////////////////////////////////////////////////////
+		void getInput(sf::Event& _event);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Draw the text area to a render window
+		///
+		/// Only the visible lines are drawn.
+		///
+		/// \param window Render window to draw to
+		/// \param states Current render states
+		///
+		////////////////////////////////////////////////////////////
+		void draw(sf::RenderWindow& window, sf::RenderStates states) const;
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief A position in the text
+		///
+		////////////////////////////////////////////////////////////
+		struct Position {
+			size_t line;   ///< The index of the line
+			size_t column; ///< The index of the character within the line
+
+			bool operator<(const Position& _other) const {
+				return line < _other.line || (line == _other.line && column < _other.column);
+			}
+			bool operator==(const Position& _other) const {
+				return line == _other.line && column == _other.column;
+			}
+			bool operator!=(const Position& _other) const {
+				return !(*this == _other);
+			}
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief A line of text and its cached layout
+		///
+		/// Whenever a line is modified it gets a new id, which is
+		/// how the visible rows know they have to be rebuilt.
+		///
+		////////////////////////////////////////////////////////////
+		struct Line {
+			std::basic_string<sf::Uint32>     text;                   ///< The characters of the line, without the line break
+			unsigned long                     id{0};                  ///< Unique id of this version of the line
+			mutable std::vector<sf::Vector2f> positions;              ///< The local positions of every character, plus the end
+			mutable bool                      layoutNeedUpdate{true}; ///< Do the positions need to be recomputed?
+		};
+
+		//Marks a row as not displaying any line yet
+		static constexpr size_t NO_LINE{size_t(-1)};
+
+		////////////////////////////////////////////////////////////
+		/// \brief A drawable row, bound to one visible line
+		///
+		////////////////////////////////////////////////////////////
+		struct Row {
+			spss::MulticolorText text;           ///< The text displaying the line
+			unsigned long        lineId{0};      ///< The id of the line version being displayed, 0 if none
+			size_t               index{NO_LINE}; ///< The index of the line being displayed, NO_LINE if none
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Handles the keys that aren't text
+		///
+		/// \param _event The key event
+		///
+		////////////////////////////////////////////////////////////
+		void handleKeyPressed(sf::Event& _event);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Handles typed characters
+		///
+		/// \param _unicode The character's Unicode code point
+		///
+		////////////////////////////////////////////////////////////
+		void handleTextEntered(sf::Uint32 _unicode);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Handles mouse clicks, drags and releases
+		///
+		/// \param _event The mouse event
+		///
+		////////////////////////////////////////////////////////////
+		void handleMouseInput(sf::Event& _event);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Replace the selection with a string
+		///
+		/// The string may contain line breaks. Only the lines that
+		/// are edited are invalidated.
+		///
+		/// \param _str The string to insert
+		///
+		////////////////////////////////////////////////////////////
+		void insert(const std::basic_string<sf::Uint32>& _str);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Erase the text between two positions
+		///
+		/// \param _begin The first position to erase
+		/// \param _end   The position after the last one to erase
+		///
+		////////////////////////////////////////////////////////////
+		void erase(const Position& _begin, const Position& _end);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Erase the selection if there is one
+		///
+		/// Returns true if anything was erased
+		///
+		////////////////////////////////////////////////////////////
+		bool eraseSelection();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the text between two positions
+		///
+		/// \param _begin The first position
+		/// \param _end   The position after the last one
+		///
+		////////////////////////////////////////////////////////////
+		std::basic_string<sf::Uint32> getText(const Position& _begin, const Position& _end) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Mark a line as modified
+		///
+		/// \param _line The index of the line
+		///
+		////////////////////////////////////////////////////////////
+		void touchLine(size_t _line);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the cached layout of a line
+		///
+		/// The positions are recomputed only if the line was
+		/// modified since they were last computed.
+		///
+		/// \param _line The index of the line
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<sf::Vector2f>& getLineLayout(size_t _line) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the position of a character in content coordinates
+		///
+		/// \param _pos The position in the text
+		///
+		////////////////////////////////////////////////////////////
+		sf::Vector2f getCharacterPos(const Position& _pos) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the text position closest to a point
+		///
+		/// \param _point The point, in content coordinates
+		///
+		////////////////////////////////////////////////////////////
+		Position getPositionAt(const sf::Vector2f& _point) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move the caret
+		///
+		/// \param _pos    The new caret position
+		/// \param _select Should the selection be extended?
+		///
+		////////////////////////////////////////////////////////////
+		void moveCaret(const Position& _pos, bool _select);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the beginning of the selection
+		///
+		////////////////////////////////////////////////////////////
+		const Position& getSelectionBegin() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the end of the selection
+		///
+		////////////////////////////////////////////////////////////
+		const Position& getSelectionEnd() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Scroll so that the caret is visible
+		///
+		////////////////////////////////////////////////////////////
+		void scrollToCaret();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update the scrollbar after the amount of lines or
+		/// the size of the text area changed
+		///
+		////////////////////////////////////////////////////////////
+		void setupScrollbar();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Resize the pool of rows to fit the visible lines
+		///
+		////////////////////////////////////////////////////////////
+		void setupRows();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the height of a line
+		///
+		////////////////////////////////////////////////////////////
+		float getLineHeight() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the top left corner of the visible content
+		///
+		/// In content coordinates, in which the top of line i is at
+		/// i * getLineHeight().
+		///
+		////////////////////////////////////////////////////////////
+		sf::Vector2f getContentOffset() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the view used to draw the visible content
+		///
+		/// Maps the visible content onto the text area through the
+		/// target's current view, clipping anything outside of it.
+		///
+		/// \param _target The render target about to be drawn to
+		///
+		////////////////////////////////////////////////////////////
+		sf::View getContentView(const sf::RenderTarget& _target) const;
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		const sf::Font&              m_font;           ///< Font used to display the text
+		unsigned int                 m_charSize;       ///< The character size
+		spss::GapBuffer<Line>        m_lines;          ///< The lines of text
+		unsigned long                m_nextLineId;     ///< The id given to the next modified line
+		mutable std::vector<Row>     m_rows;           ///< The rows used to draw the visible lines
+		mutable spss::MulticolorText m_measureText;    ///< Used to lay out lines that aren't visible
+		sf::RectangleShape           m_rectangle;      ///< The background rectangle
+		sf::RectangleShape           m_caret;          ///< The caret
+		mutable sf::VertexArray      m_highlight;      ///< The selection highlight of the visible lines
+		sf::Color                    m_textFillColor;  ///< The text's fill color
+		Position                     m_caretPos;       ///< The position of the caret
+		Position                     m_anchorPos;      ///< The position the selection started at
+		float                        m_preferredX;     ///< The X the caret tries to keep when moving up/down
+		float                        m_scrollX;        ///< How far the content is scrolled horizontally
+		bool                         m_enteringText;   ///< Is the text area accepting input?
+		bool                         m_mouseSelecting; ///< Is the user dragging to select text?
+		sf::Clock                    m_caretClock;     ///< Used to blink the caret
+		mutable sf::RenderWindow*    m_window;         ///< The window the text area was last drawn to
+		mutable sf::View             m_backgroundView; ///< The view the text area was last drawn with
+		sf::View                     m_scrollView;     ///< The view whose center the scrollbar moves
+		spss::Scrollbar              m_scrollbar;      ///< The vertical scrollbar
+	};
+
+} //namespace spss
@@ -12,13 +12,22 @@
 ///
 /// The text the user types is of the customised spss::MulticolorText
 /// type, which removes sf::Text's limitations of being able to only
-/// set one color for the entire text object. An spss::TextEntryBox
-/// object will thus automatically make text that overflows out of the
-/// box transparent.
+/// set one color for the entire text object. Text that overflows out
+/// of the box is clipped by drawing it through a view whose viewport
+/// only covers the box.
+///
+/// A spss::CompletionProvider can be attached to suggest completions
+/// for the word at the caret, which are shown in a dropdown below
+/// the box.
 ///
 ////////////////////////////////////////////////////////////////////
 
 #include <SPSS/Graphics/MulticolorText.h>
+#include <SPSS/System/Animator.h>
+#include <SPSS/Util/CompletionProvider.h>
+#include <SPSS/Util/EditHistory.h>
+#include <SPSS/Util/GapBuffer.h>
+#include <SPSS/Util/WordIndex.h>
 #include <SFML/Graphics.hpp>
 
 namespace spss {
@@ -31,7 +40,7 @@ namespace spss {
 		/// \param _font     Font used to draw text
 		/// \param _charSize The character size
 		/// \param _width    The width of the box
-		/// \param _str      The default string value
+		/// \param _str      The default string value, encoded in UTF-8
 		///
 		////////////////////////////////////////////////////////////
 		TextEntryBox(const float         _width,
@@ -194,6 +203,11 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Set the maximum amount of characters
 		///
+		/// By default, up to 2^14 characters can be entered, which
+		/// can still be pasted within a frame. Every character is
+		/// laid out as its own glyph, so pasting a megabyte of text
+		/// takes a lot longer (see demo/paste_benchmark.cpp).
+		///
 		/// \param _i The maximum amount of characters
 		///
 		////////////////////////////////////////////////////////////
@@ -222,6 +236,33 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void setAlwaysActive(bool _b);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Set the maximum amount of memory the undo history uses
+		///
+		/// Once the history grows past this, the oldest edits are
+		/// forgotten. By default, it's one megabyte.
+		///
+		/// \param _bytes The maximum amount of bytes
+		///
+		////////////////////////////////////////////////////////////
+		void setUndoMemoryCap(size_t _bytes);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the provider used to suggest completions
+		///
+		/// While the word at the caret isn't empty, up to
+		/// _maxSuggestions completions for it are shown below the
+		/// box. UP and DOWN pick a suggestion, and TAB accepts it.
+		/// The provider is only queried when the text or the caret
+		/// changes, and must outlive the box.
+		///
+		/// \param _provider       The provider, or nullptr to disable completion
+		/// \param _maxSuggestions The maximum amount of suggestions to show
+		///
+		////////////////////////////////////////////////////////////
+		void setCompletionProvider(const spss::CompletionProvider* _provider,
+		                           size_t                          _maxSuggestions = 8);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Set the width of the text entry box
 		///
@@ -324,14 +365,26 @@ namespace spss {
 		///
 		/// After RETURN is pressed, the contents of the text entry box
 		/// are cleared and moved over to m_lastString. It can be retr-
-		/// ieved via this function.
+		/// ieved via this function. The string is encoded in UTF-8.
 		///
 		////////////////////////////////////////////////////////////
 		const std::string getLastString() const;
 
+		////////////////////////////////////////////////////////////
+		/// \brief Clear the contents, the last string and the undo history
+		///
+		/// Leaves the box as if it had just been constructed without
+		/// a default string, so that it can be reused.
+		///
+		////////////////////////////////////////////////////////////
+		void clear();
+
 		////////////////////////////////////////////////////////////
 		/// \brief Returns the current contents of the text entry box
 		///
+		/// The contents are stored as UTF-32, and are only encoded
+		/// in UTF-8 when this function is called.
+		///
 		////////////////////////////////////////////////////////////
 		const std::string getCurrentString() const;
 
@@ -343,6 +396,27 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void setActive(bool _b);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Undo the last edit
+		///
+		/// Consecutive keystrokes are undone together. Also bound
+		/// to CTRL+Z.
+		///
+		/// \see redo
+		///
+		////////////////////////////////////////////////////////////
+		void undo();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Redo the last undone edit
+		///
+		/// Also bound to CTRL+Y and CTRL+SHIFT+Z.
+		///
+		/// \see undo
+		///
+		////////////////////////////////////////////////////////////
+		void redo();
+
 	  private:
 		////////////////////////////////////////////////////////////
 		/// \brief Used to denote the current selection direction
@@ -371,38 +445,56 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Sets the text position.
 		///
-		/// Sets the text's position and then calls updateCaret,
-		/// updateHighlight, and updateAlpha
+		/// Sets the text's position and then calls updateCaret and
+		/// updateHighlight
 		///
 		/// \see updateCaret
 		/// \see updateHighlight
-		/// \see updateAlpha
 		///
 		////////////////////////////////////////////////////////////
 		void setTextPosition(const sf::Vector2f& _pos);
 
 		////////////////////////////////////////////////////////////
-		/// \brief Sets the text's string
+		/// \brief Replaces the contents of the text entry box
 		///
-		/// Since MulticolorText will lose its outline thickness
-		/// when changing its string, we'll use this function to
-		/// reset it every time we change the string. Also calls
-		/// shiftTextToRight.
+		/// Since the new contents aren't an edit of the old ones,
+		/// the undo history is cleared.
 		///
-		/// \see setOutlineThickness
-		/// \see shiftTextToRight
+		/// \param _str The new contents
+		///
+		/// \see updateTextString
 		///
 		////////////////////////////////////////////////////////////
-		void setTextString(const std::string& _str);
+		void setTextString(const sf::String& _str);
 
 		////////////////////////////////////////////////////////////
-		/// \brief Updates the transparency of overflowing text
+		/// \brief Updates the text's string after an edit
+		///
+		/// Applies the same edit as m_buffer's to m_text, so that
+		/// only the characters from the edit onwards are laid out
+		/// and measured again.
 		///
-		/// Checks for letters that are outside of the bounds of
-		/// the box and makes them transparent.
+		/// \param _pos    The index of the first replaced character
+		/// \param _count  The amount of replaced characters
+		/// \param _insert The characters inserted in their place
 		///
 		////////////////////////////////////////////////////////////
-		void updateAlpha() const;
+		void updateTextString(size_t _pos, size_t _count, const sf::String& _insert);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the view used to clip the text to the box
+		///
+		/// Returns a view that shows exactly the box's area, with a
+		/// viewport covering only the box. Drawing through it draws
+		/// everything in the same place as the target's current view,
+		/// but discards anything outside of the box.
+		///
+		/// \param _target The render target about to be drawn to
+		/// \param _states The render states used to draw the box
+		///
+		////////////////////////////////////////////////////////////
+		sf::View getClippingView(const sf::RenderTarget& _target,
+		                         const sf::RenderStates& _states) const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Updates caret's position and transparency value
@@ -477,13 +569,10 @@ namespace spss {
 		/// If the caret goes out of the right edge of the box, this
 		/// function shifts the position of m_text to the left as much
 		/// as neccessary to ensure that the caret is still visible.
-		/// Note that text out of bounds of the box will become trans-
-		/// parent.
+		/// Note that text out of bounds of the box will be clipped.
 		///
 		/// Returns true if the text was shifted
 		///
-		/// \see updateAlpha
-		///
 		///////////////////////////////////////////////////////////
 		bool shiftTextToLeft();
 
@@ -493,16 +582,72 @@ namespace spss {
 		/// If the caret goes out of the left edge of the box, this
 		/// function shifts the position of m_text to the right as much
 		/// as neccessary to ensure that the caret is still visible.
-		/// Note that text out of bounds of the box will become trans-
-		/// parent.
+		/// Note that text out of bounds of the box will be clipped.
 		///
 		/// Returns true if the text was shifted
 		///
-		/// \see updateAlpha
-		///
 		///////////////////////////////////////////////////////////
 		bool shiftTextToRight();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Get the global position of a character
+		///
+		/// Same as m_text.findCharacterPos, but looked up in a table
+		/// of every character's position, which is only rebuilt
+		/// when the text changes.
+		///
+		/// \param _index The index of the character
+		///
+		/// \see getCharacterAt
+		///
+		///////////////////////////////////////////////////////////
+		sf::Vector2f getCharacterPos(size_t _index) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the caret position closest to a point
+		///
+		/// Binary searches the table of character positions, so
+		/// it's O(log n).
+		///
+		/// \param _point The point, in global coordinates
+		///
+		/// \see getCharacterPos
+		///
+		///////////////////////////////////////////////////////////
+		size_t getCharacterAt(const sf::Vector2f& _point) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Handles mouse clicks, drags and releases
+		///
+		/// Clicking inside the box moves the caret, double clicking
+		/// selects a word, and dragging selects text. Does nothing
+		/// until the box has been drawn, since the mouse position
+		/// is mapped through the target it was drawn to.
+		///
+		/// \param _event The mouse event
+		///
+		///////////////////////////////////////////////////////////
+		void handleMouseInput(sf::Event& _event);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Selects the text between two positions
+		///
+		/// The caret is placed at _pos.
+		///
+		/// \param _anchor The position the selection started at
+		/// \param _pos    The position the selection ends at
+		///
+		///////////////////////////////////////////////////////////
+		void selectRange(size_t _anchor, size_t _pos);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Selects the word at a position
+		///
+		/// \param _pos A position within or at either end of the word
+		///
+		///////////////////////////////////////////////////////////
+		void selectWordAt(size_t _pos);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Resets the text's position
 		///
@@ -550,13 +695,13 @@ namespace spss {
 		/// \brief Get the contents of the current selection
 		///
 		///////////////////////////////////////////////////////////
-		const std::string getSelection() const;
+		const sf::String getSelection() const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Is the input valid?
 		///
-		/// Anything between 32 and 255 represents the  alphanumeric
-		/// characters, and some symbols.
+		/// Any Unicode code point is valid, except for control
+		/// characters.
 		///
 		/// \see insert
 		///
@@ -566,14 +711,24 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Insert the string into the currently selected position
 		///
+		/// Control characters such as line breaks and tabs are
+		/// filtered out and the string is truncated to fit within
+		/// the maximum amount of characters in a single pass, after
+		/// which the edit is applied and the text is laid out once,
+		/// so that pasting large strings stays cheap.
+		///
+		/// \param _str The string to insert
+		///
 		///////////////////////////////////////////////////////////
-		void insert(std::string& _str);
+		void insert(const sf::String& _str);
 
 		////////////////////////////////////////////////////////////
-		/// \brief Insert the char into the currently selected position
+		/// \brief Insert the character into the currently selected position
+		///
+		/// \param _unicode The character's Unicode code point
 		///
 		///////////////////////////////////////////////////////////
-		void insert(char _char);
+		void insert(sf::Uint32 _unicode);
 
 		////////////////////////////////////////////////////////////
 		/// \brief Clear all the contents of the text entry box
@@ -581,6 +736,19 @@ namespace spss {
 		///////////////////////////////////////////////////////////
 		void clearText();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Replace a range of characters without recording it
+		///
+		/// Used to revert and reapply edits from the undo history.
+		/// The caret is placed after the inserted characters.
+		///
+		/// \param _pos    The position of the first replaced character
+		/// \param _count  The amount of characters to replace
+		/// \param _insert The characters to insert in their place
+		///
+		///////////////////////////////////////////////////////////
+		void applyEdit(size_t _pos, size_t _count, const std::basic_string<sf::Uint32>& _insert);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Increments/decrements m_selectionBegin safely
 		///
@@ -609,30 +777,79 @@ namespace spss {
 		///////////////////////////////////////////////////////////
 		bool textTooWide() const;
 
+		////////////////////////////////////////////////////////////
+		/// \brief Queries the completion provider for suggestions
+		///
+		/// The word before the caret is used as the prefix. The
+		/// dropdown is laid out here, so drawing it is free.
+		///
+		/// \see acceptSuggestion
+		///
+		///////////////////////////////////////////////////////////
+		void updateSuggestions();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Hides the suggestions until the next edit
+		///
+		///////////////////////////////////////////////////////////
+		void clearSuggestions();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Replaces the word before the caret with the selected suggestion
+		///
+		/// The replacement is recorded as a single edit.
+		///
+		/// \see updateSuggestions
+		///
+		///////////////////////////////////////////////////////////
+		void acceptSuggestion();
+
 		///////////////////////////////////////////////////////////
 		//Data members --------------------------------------------
 		///////////////////////////////////////////////////////////
 
-		const sf::Font&              m_font;                 ///< Font used to display the title and menu items
-		sf::RectangleShape           m_rectangle;            ///< The background rectangle
-		sf::RectangleShape           m_highlightedRectangle; ///< The rectangle used to highlight the current selection
-		size_t                       m_selectionBegin;       ///< The beginning index of the current selection
-		size_t                       m_selectionEnd;         ///< The end index of the current selection
-		SELDIR                       m_selectionDirection;   ///< What direction the user is selecting text in
-		mutable spss::MulticolorText m_text;                 ///< The text used to display what the user is entering
-		sf::Text                     m_caret;                ///< The caret
-		bool                         m_enteringText;         ///< Is the text entry box active, i.e. accepting input?
-		mutable bool                 m_inputComplete;        ///< Did the user finish entering text (press RETURN)?
-		bool                         m_alwaysVisible;        ///< Display the box at all times, even when m_enteringText is false?
-		bool                         m_alwaysActive;         ///< m_enteringText is always set to true and prevent text from being cleared upon pressing RETURN?
-		std::string                  m_lastString;           ///< The last string entered by the user (RETURN was pressed)
-		unsigned int                 m_charSize;             ///< m_text's character size
-		unsigned int                 m_maxChars;             ///< The maximum amount of characters that can be entered
-		sf::Color                    m_textFillColor;        ///< m_text's fill color
-		sf::Color                    m_textOutlineColor;     ///< m_text's outline color
-		float                        m_textOutlineThickness; ///< m_text's outline thickness
-		mutable bool                 m_alphaUpdateNeeded;    ///< Does the transparency need to be rechecked when next possible?
-		float                        m_xOffset;              ///< The delta offset that's been applied to the text's position via the shifting left/right functions
+		const sf::Font&                   m_font;                    ///< Font used to display the title and menu items
+		spss::GapBuffer<sf::Uint32>       m_buffer;                  ///< The contents of the box, which all edits are applied to
+		spss::WordIndex                   m_wordIndex;               ///< The word boundaries of m_buffer
+		spss::EditHistory<sf::Uint32>     m_history;                 ///< The edits that can be undone/redone
+		sf::RectangleShape                m_rectangle;               ///< The background rectangle
+		sf::RectangleShape                m_highlightedRectangle;    ///< The rectangle used to highlight the current selection
+		size_t                            m_selectionBegin;          ///< The beginning index of the current selection
+		size_t                            m_selectionEnd;            ///< The end index of the current selection
+		SELDIR                            m_selectionDirection;      ///< What direction the user is selecting text in
+		mutable spss::MulticolorText      m_text;                    ///< The text used to display what the user is entering
+		sf::Text                          m_caret;                   ///< The caret
+		bool                              m_enteringText;            ///< Is the text entry box active, i.e. accepting input?
+		mutable bool                      m_inputComplete;           ///< Did the user finish entering text (press RETURN)?
+		bool                              m_alwaysVisible;           ///< Display the box at all times, even when m_enteringText is false?
+		bool                              m_alwaysActive;            ///< m_enteringText is always set to true and prevent text from being cleared upon pressing RETURN?
+		std::string                       m_lastString;              ///< The last string entered by the user (RETURN was pressed), in UTF-8
+		unsigned int                      m_charSize;                ///< m_text's character size
+		unsigned int                      m_maxChars;                ///< The maximum amount of characters that can be entered
+		sf::Color                         m_textFillColor;           ///< m_text's fill color
+		sf::Color                         m_textOutlineColor;        ///< m_text's outline color
+		float                             m_textOutlineThickness;    ///< m_text's outline thickness
+		float                             m_xOffset;                 ///< The delta offset that's been applied to the text's position via the shifting left/right functions
+		mutable std::vector<sf::Vector2f> m_charPositions;           ///< The local positions of every character in m_text, plus its end
+		mutable bool                      m_charPositionsNeedUpdate; ///< Does m_charPositions need to be rebuilt?
+		mutable size_t                    m_charPositionsStart;      ///< The first position in m_charPositions that changed
+		mutable const sf::RenderTarget*   m_target;                  ///< The target the box was last drawn to, used to map mouse coordinates
+		mutable sf::View                  m_clipView;                ///< The view the text was last drawn through, used to map mouse coordinates
+		bool                              m_mouseSelecting;          ///< Is the user dragging to select text?
+		size_t                            m_mouseAnchor;             ///< The position the current drag started at
+		size_t                            m_lastClickPos;            ///< The position of the last click, to detect double clicks
+		sf::Clock                         m_clickClock;              ///< Time since the last click, to detect double clicks
+		spss::Animator::Tween             m_caretBlink;              ///< The caret's alpha, fading in and out
+		const spss::CompletionProvider*   m_completionProvider;      ///< The provider suggesting completions, if any
+		size_t                            m_maxSuggestions;          ///< The maximum amount of suggestions to show
+		std::vector<std::string>          m_suggestions;             ///< The current suggestions, in UTF-8
+		std::vector<sf::Text>             m_suggestionTexts;         ///< The texts displaying m_suggestions
+		sf::RectangleShape                m_suggestionBox;           ///< The dropdown's background rectangle
+		sf::RectangleShape                m_suggestionHighlight;     ///< The rectangle highlighting the selected suggestion
+		size_t                            m_selectedSuggestion;      ///< The index of the selected suggestion
+		size_t                            m_completionStart;         ///< The position of the word being completed
+		size_t                            m_completionEnd;           ///< The caret position the suggestions were found for
+		bool                              m_suggestionsNeedUpdate;   ///< Has the text changed since the suggestions were found?
 	};
 
 } //namespace spss
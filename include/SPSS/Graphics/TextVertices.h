@@ -0,0 +1,53 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// Helpers for building text geometry outside of sf::Text, so that
+/// many texts sharing a font and character size can be batched into
+/// a single vertex array and drawn with a single draw call.
+////////////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a glyph quad to a vertex array
+	///
+	/// Appends two triangles (6 vertices) with texture coordinates
+	/// in pixels.
+	///
+	/// \param vertices         The vertex array to append to
+	/// \param position         The position of the glyph's baseline origin
+	/// \param color            The color of the glyph
+	/// \param glyph            The glyph
+	/// \param italicShear      The shear applied to italic text
+	/// \param outlineThickness The thickness of the glyph's outline, if it's one
+	///
+	////////////////////////////////////////////////////////////
+	void addGlyphQuad(sf::VertexArray& vertices,
+	                  sf::Vector2f     position,
+	                  const sf::Color& color,
+	                  const sf::Glyph& glyph,
+	                  float            italicShear,
+	                  float            outlineThickness = 0);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append an sf::Text's geometry to a vertex array
+	///
+	/// The vertices are laid out the same way sf::Text lays them
+	/// out, outline first, and then transformed by the text's
+	/// transform. The array has to use sf::Triangles, and be drawn
+	/// with the font's texture for the text's character size.
+	///
+	/// Only the regular style is supported, with the default line
+	/// and letter spacing.
+	///
+	/// \param _vertices The vertex array to append to
+	/// \param _text     The text to append
+	///
+	////////////////////////////////////////////////////////////
+	void appendTextVertices(sf::VertexArray& _vertices, const sf::Text& _text);
+
+} //namespace spss
@@ -0,0 +1,128 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::TileCache keeps a rendered copy of scrollable content that
+/// rarely changes (menus, help text, credits, ...), so that it
+/// doesn't have to be drawn from scratch every frame.
+///
+/// The content is split into horizontal strips (tiles) as wide as
+/// the view, each rendered into its own sf::RenderTexture the first
+/// time it comes into view. From then on, drawing the cache only
+/// draws the tiles in view as textured quads, so scrolling costs
+/// the same however much content there is. A tile is only rendered
+/// again once its content has been invalidated, or once its texture
+/// has been handed over to a tile closer to the view because the
+/// cache was full.
+///
+/// The content is drawn by a user supplied function, in the same
+/// coordinates as the view the cache is drawn with. That view has
+/// to map one unit to one pixel, or the cached content will look
+/// scaled.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/Function.h>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <map>
+#include <memory>
+
+namespace spss {
+
+	class TileCache : public sf::Drawable {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty cache
+		///
+		/// \param _tileHeight The height of each tile, in pixels
+		/// \param _maxTiles   How many tiles to keep before reusing the farthest ones
+		///
+		////////////////////////////////////////////////////////////
+		TileCache(unsigned int _tileHeight = 256, size_t _maxTiles = 16);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the function that draws the content
+		///
+		/// The function is given a render target whose view is
+		/// already set to the tile's area, and should simply draw
+		/// everything to it.
+		///
+		/// \param _render The function
+		///
+		////////////////////////////////////////////////////////////
+		void setRenderer(Function<sf::RenderTarget&> _render);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Render every tile again the next time it's drawn
+		///
+		////////////////////////////////////////////////////////////
+		void invalidate();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Render the tiles overlapping a vertical range again
+		///
+		/// \param _top    The top of the range whose content changed
+		/// \param _bottom The bottom of the range whose content changed
+		///
+		////////////////////////////////////////////////////////////
+		void invalidate(float _top, float _bottom);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Release every tile's texture
+		///
+		////////////////////////////////////////////////////////////
+		void clear();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of tiles currently held
+		///
+		////////////////////////////////////////////////////////////
+		size_t getTileCount() const;
+
+	  protected:
+		////////////////////////////////////////////////////////////
+		/// \brief Draw the tiles in view, rendering them if needed
+		///
+		/// If a tile's texture can't be created, the content is
+		/// drawn directly instead.
+		///
+		/// \param target Render target to draw to
+		/// \param states Current render states
+		///
+		////////////////////////////////////////////////////////////
+		void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief A strip of rendered content
+		///
+		////////////////////////////////////////////////////////////
+		struct Tile {
+			std::unique_ptr<sf::RenderTexture> texture; ///< The rendered content
+			bool                               dirty;   ///< Does the content need to be rendered again?
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get a tile in view, up to date
+		///
+		/// \param _index The tile's index, counting from y = 0
+		/// \param _first The index of the first tile in view
+		/// \param _last  The index of the last tile in view
+		///
+		/// \return The tile's texture, or nullptr if it couldn't be created
+		///
+		////////////////////////////////////////////////////////////
+		const sf::RenderTexture* prepareTile(int _index, int _first, int _last) const;
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		Function<sf::RenderTarget&> m_render;     ///< Draws the content
+		unsigned int                m_tileHeight; ///< The height of each tile, in pixels
+		size_t                      m_maxTiles;   ///< How many tiles to keep before reusing the farthest ones
+		mutable float               m_left;       ///< The left of the tiles, in content coordinates
+		mutable float               m_width;      ///< The width of the tiles, in pixels
+		mutable std::map<int, Tile> m_tiles;      ///< The tiles, by index
+	};
+
+} //namespace spss
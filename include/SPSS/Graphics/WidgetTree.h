@@ -0,0 +1,415 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::WidgetTree drives a state's widgets (TextEntryBox, Slider,
+/// DialogPrompt, TextArea, Scrollbar, ...) so that the state only
+/// has to pass it its events and call update() and draw() once.
+///
+/// Widgets are added as nodes, either at the root or under another
+/// node; groups are nodes without a widget, used to move several
+/// widgets together. A node's position is relative to its parent,
+/// and the tree passes each widget its position in the window with
+/// setPosition(), so the widgets keep on handling the mouse in
+/// window coordinates like they always have. Widgets are drawn in
+/// the order they were added, children above their parents.
+///
+/// Each node has two dirty flags, which are propagated up to the
+/// root so that update() only walks the subtrees that have some-
+/// thing to do:
+///
+/// * Layout: the node moved, so it and its descendants have to be
+///   positioned again.
+/// * Paint: the widget has to be updated. Nodes get this flag when
+///   they receive an event, while they have focus or the mouse is
+///   held down on them, when invalidatePaint() is called, and every
+///   frame if they're animated.
+///
+/// Updated and moved widgets are filed into a grid by their bounds,
+/// so that mouse events only go to the widget in front under the
+/// cursor (and the one the mouse was pressed on, until it's
+/// released), rather than to every widget. Keyboard events only go
+/// to the focused widget, which is the last one clicked. Widgets
+/// without a getGlobalBounds() function returning an sf::FloatRect
+/// by value (like Scrollbar) can't be filed, so they get every
+/// mouse event and are always updated.
+///
+/// Widgets are drawn with the window's current view, and only if
+/// they're in view. The tree doesn't own its widgets, which have
+/// to outlive their nodes.
+///
+/// Removing a node is deferred until the end of getInput() or
+/// update(), so a widget's callback can safely remove it.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Graphics/DrawableToWindow.h>
+#include <SFML/Window/Event.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace spss {
+
+	class WidgetTree : public spss::DrawableToWindow {
+	  public:
+		using NodeId = size_t;
+
+		static constexpr NodeId ROOT{0};
+		static constexpr NodeId NO_NODE{static_cast<NodeId>(-1)};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct a tree with only a root
+		///
+		/// \param _window The window the widgets are drawn to
+		///
+		////////////////////////////////////////////////////////////
+		WidgetTree(sf::RenderWindow& _window);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a widget
+		///
+		/// The widget needs getInput(sf::Event&) and update()
+		/// functions, and to be drawable. If it has a
+		/// setPosition(sf::Vector2f) function, it's positioned by
+		/// the tree.
+		///
+		/// \param _widget   The widget
+		/// \param _position The position, relative to the parent
+		/// \param _parent   The parent node
+		///
+		/// \return The widget's node
+		///
+		////////////////////////////////////////////////////////////
+		template<typename W>
+		NodeId add(W& _widget, const sf::Vector2f& _position = {}, NodeId _parent = ROOT) {
+			return addNode(&_widget, &OPS<W>, _position, _parent);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a group, to hold other nodes
+		///
+		/// \param _position The position, relative to the parent
+		/// \param _parent   The parent node
+		///
+		/// \return The group's node
+		///
+		////////////////////////////////////////////////////////////
+		NodeId addGroup(const sf::Vector2f& _position = {}, NodeId _parent = ROOT);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Remove a node and its descendants
+		///
+		/// The node's id may be handed out again afterwards.
+		///
+		/// \param _node The node
+		///
+		////////////////////////////////////////////////////////////
+		void remove(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set a node's position, relative to its parent
+		///
+		/// \param _node     The node
+		/// \param _position The position
+		///
+		////////////////////////////////////////////////////////////
+		void setPosition(NodeId _node, const sf::Vector2f& _position);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get a node's position, relative to its parent
+		///
+		/// \param _node The node
+		///
+		////////////////////////////////////////////////////////////
+		const sf::Vector2f& getPosition(NodeId _node) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set whether a node and its descendants are shown
+		///
+		/// Hidden widgets aren't drawn, updated, or given events.
+		///
+		/// \param _node    The node
+		/// \param _visible Is it shown?
+		///
+		////////////////////////////////////////////////////////////
+		void setVisible(NodeId _node, bool _visible);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set whether a widget is updated every frame
+		///
+		/// For widgets that change on their own, like ones that
+		/// blink or glide.
+		///
+		/// \param _node     The node
+		/// \param _animated Is it updated every frame?
+		///
+		////////////////////////////////////////////////////////////
+		void setAnimated(NodeId _node, bool _animated);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Position a node and its descendants again
+		///
+		/// Call this after changing a widget in a way that moves
+		/// it, since the tree can't tell.
+		///
+		/// \param _node The node
+		///
+		////////////////////////////////////////////////////////////
+		void invalidateLayout(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update a widget during the next update()
+		///
+		/// Call this after changing a widget outside of the tree,
+		/// so that it's updated and filed again.
+		///
+		/// \param _node The node
+		///
+		////////////////////////////////////////////////////////////
+		void invalidatePaint(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Give a widget the keyboard focus
+		///
+		/// \param _node The node, or NO_NODE to clear the focus
+		///
+		////////////////////////////////////////////////////////////
+		void setFocus(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the node with the keyboard focus
+		///
+		/// \return The node, or NO_NODE
+		///
+		////////////////////////////////////////////////////////////
+		NodeId getFocus() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of nodes, including the root
+		///
+		////////////////////////////////////////////////////////////
+		size_t getNodeCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get input
+		///
+		/// \param _e A reference to a captured event
+		///
+		////////////////////////////////////////////////////////////
+		void getInput(sf::Event& _e);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Position and update the dirty nodes
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Draw the widgets in view
+		///
+		/// \param window Render window to draw to
+		/// \param states Current render states
+		///
+		////////////////////////////////////////////////////////////
+		void draw(sf::RenderWindow& window, sf::RenderStates states) const;
+
+	  private:
+		using SetPosition = void (*)(void*, const sf::Vector2f&);
+		using GetBounds   = sf::FloatRect (*)(const void*);
+
+		////////////////////////////////////////////////////////////
+		/// \brief The operations on a widget's type
+		///
+		/// One table exists per widget type, so that the nodes can
+		/// hold widgets of any type without them sharing a base.
+		///
+		////////////////////////////////////////////////////////////
+		struct WidgetOps {
+			void (*getInput)(void*, sf::Event&);
+			void (*update)(void*);
+			void (*draw)(const void*, sf::RenderWindow&, sf::RenderStates);
+			SetPosition setPosition; ///< nullptr if the widget can't be positioned
+			GetBounds   getBounds;   ///< nullptr if the widget has no bounds
+		};
+
+		template<typename W, typename = void>
+		struct IsPositionable : std::false_type {};
+
+		template<typename W>
+		struct IsPositionable<W, std::void_t<decltype(std::declval<W&>().setPosition(sf::Vector2f{}))>>
+		            : std::true_type {};
+
+		template<typename W, typename = void>
+		struct IsBounded : std::false_type {};
+
+		//Bounds returned by reference can't be told apart from a
+		//reference to a temporary, so they're not trusted
+		template<typename W>
+		struct IsBounded<W, std::void_t<decltype(std::declval<const W&>().getGlobalBounds())>>
+		            : std::is_same<std::remove_const_t<decltype(std::declval<const W&>().getGlobalBounds())>, sf::FloatRect> {};
+
+		template<typename W>
+		static constexpr SetPosition positionerFor() {
+			if constexpr (IsPositionable<W>::value) {
+				return [](void* _widget, const sf::Vector2f& _position) {
+					static_cast<W*>(_widget)->setPosition(_position);
+				};
+			}
+			else {
+				return nullptr;
+			}
+		}
+
+		template<typename W>
+		static constexpr GetBounds boundsFor() {
+			if constexpr (IsBounded<W>::value) {
+				return [](const void* _widget) -> sf::FloatRect {
+					return static_cast<const W*>(_widget)->getGlobalBounds();
+				};
+			}
+			else {
+				return nullptr;
+			}
+		}
+
+		template<typename W>
+		static constexpr WidgetOps OPS{
+		  [](void* _widget, sf::Event& _e) {
+			  static_cast<W*>(_widget)->getInput(_e);
+		  },
+		  [](void* _widget) {
+			  static_cast<W*>(_widget)->update();
+		  },
+		  [](const void* _widget, sf::RenderWindow& _window, sf::RenderStates _states) {
+			  _window.draw(*static_cast<const W*>(_widget), _states);
+		  },
+		  positionerFor<W>(),
+		  boundsFor<W>()};
+
+		////////////////////////////////////////////////////////////
+		/// \brief A widget or a group
+		///
+		////////////////////////////////////////////////////////////
+		struct Node {
+			void*               widget;        ///< The widget, or nullptr for groups and free nodes
+			const WidgetOps*    ops;           ///< The widget's operations, or nullptr
+			NodeId              parent;        ///< The parent node, or NO_NODE
+			std::vector<NodeId> children;      ///< The child nodes, back to front
+			sf::Vector2f        position;      ///< The position, relative to the parent
+			sf::Vector2f        worldPosition; ///< The position in the window
+			sf::FloatRect       bounds;        ///< The bounds the widget is filed with
+			size_t              order;         ///< The position in the drawing order
+			bool                alive;         ///< Is the node in use?
+			bool                visible;       ///< Was the node set to be shown?
+			bool                shown;         ///< Are the node and all its ancestors set to be shown?
+			bool                animated;      ///< Is the widget updated every frame?
+			bool                indexed;       ///< Is the widget filed in the grid?
+			bool                layoutDirty;   ///< Do the node and its descendants need to be positioned?
+			bool                paintDirty;    ///< Does the widget need to be updated?
+			bool                childDirty;    ///< Does a descendant have a dirty flag set?
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a node holding any widget, or none
+		///
+		////////////////////////////////////////////////////////////
+		NodeId addNode(void* _widget, const WidgetOps* _ops, const sf::Vector2f& _position, NodeId _parent);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is the id that of a node in use?
+		///
+		////////////////////////////////////////////////////////////
+		bool isAlive(NodeId _node) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Let the ancestors know that a descendant is dirty
+		///
+		/// \param _node The dirty node
+		///
+		////////////////////////////////////////////////////////////
+		void propagateDirty(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Position and update a node and its descendants
+		///
+		/// \param _node        The node
+		/// \param _layoutDirty Was the parent positioned again?
+		///
+		////////////////////////////////////////////////////////////
+		void updateNode(NodeId _node, bool _layoutDirty);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Work out the drawing order and which nodes are shown
+		///
+		////////////////////////////////////////////////////////////
+		void rebuildOrder();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Pass an event to a widget, marking it for update
+		///
+		////////////////////////////////////////////////////////////
+		void dispatch(NodeId _node, sf::Event& _e);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Pass an event to every widget without bounds
+		///
+		////////////////////////////////////////////////////////////
+		void dispatchUnbounded(sf::Event& _e);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the widget in front under the cursor
+		///
+		/// \return The widget's node, or NO_NODE
+		///
+		////////////////////////////////////////////////////////////
+		NodeId findNodeUnderCursor() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief File a widget into the grid by its current bounds
+		///
+		////////////////////////////////////////////////////////////
+		void index(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Take a widget out of the grid
+		///
+		////////////////////////////////////////////////////////////
+		void unindex(NodeId _node);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the key of the grid cell holding a point
+		///
+		////////////////////////////////////////////////////////////
+		static std::uint64_t cellKey(int _x, int _y);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Free the nodes removed so far
+		///
+		////////////////////////////////////////////////////////////
+		void releaseRemoved();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Free a node and its descendants
+		///
+		////////////////////////////////////////////////////////////
+		void release(NodeId _node);
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		sf::RenderWindow&                                      m_window;     ///< The window the widgets are drawn to
+		std::vector<Node>                                      m_nodes;      ///< The nodes, by id
+		std::vector<NodeId>                                    m_freeNodes;  ///< The ids of the free nodes
+		std::vector<NodeId>                                    m_removed;    ///< The nodes to free
+		std::vector<NodeId>                                    m_drawOrder;  ///< The shown widgets, back to front
+		std::vector<NodeId>                                    m_unbounded;  ///< The widgets without bounds
+		std::unordered_map<std::uint64_t, std::vector<NodeId>> m_grid;       ///< The bounded widgets, by the cells they overlap
+		bool                                                   m_orderDirty; ///< Does the drawing order need to be worked out again?
+		NodeId                                                 m_focus;      ///< The widget with the keyboard focus
+		NodeId                                                 m_captured;   ///< The widget the mouse was pressed on, until it's released
+		NodeId                                                 m_hovered;    ///< The widget under the cursor
+	};
+
+} //namespace spss
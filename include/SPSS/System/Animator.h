@@ -0,0 +1,289 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::Animator interpolates values over time, so that widgets
+/// don't have to hand-roll their own per-frame animation math.
+///
+/// Starting a tween returns an Animator::Tween, a handle through
+/// which the widget reads the current value. The tween stops when
+/// its handle is destroyed, so every widget owns its own animation
+/// state and nothing is shared between instances.
+///
+/// Float, vector and color tweens are all split into float tracks,
+/// stored as parallel arrays (elapsed time, duration, start and end
+/// values, ...), and update() advances every track at once in a few
+/// tight loops over those arrays, which the compiler can vectorize.
+/// To that end, a track's repeat mode and easing curve are stored as
+/// numbers that the same arithmetic is applied to, rather than as
+/// enums that would have to be switched on.
+/// Removing a track swaps the last one into its place, so the
+/// arrays stay contiguous.
+///
+/// spss::Core updates the animator before updating the states.
+/// Programs that don't use spss::Core should call update() once
+/// per timeslice themselves.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/Singleton.h>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <array>
+#include <vector>
+
+namespace spss {
+
+	class Animator : public spss::Singleton<Animator> {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief The curve a tween follows between its two values
+		///
+		////////////////////////////////////////////////////////////
+		enum class Easing {
+			Linear,    ///< Constant speed
+			QuadIn,    ///< Starts slow and speeds up
+			QuadOut,   ///< Starts fast and slows down
+			QuadInOut, ///< Starts and ends slow
+			SineInOut  ///< Starts and ends slow, more gently than QuadInOut
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief What a tween does once it reaches its end value
+		///
+		////////////////////////////////////////////////////////////
+		enum class Repeat {
+			Once,    ///< Stay at the end value
+			Loop,    ///< Jump back to the start value
+			PingPong ///< Head back to the start value, and so on
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief A handle to a running tween
+		///
+		/// Move-only. Destroying the handle stops the tween, and a
+		/// default constructed handle doesn't refer to any tween
+		/// and always reads as 0.
+		///
+		////////////////////////////////////////////////////////////
+		class Tween {
+		  public:
+			Tween();
+			Tween(Tween&& _other) noexcept;
+			Tween& operator=(Tween&& _other) noexcept;
+			Tween(const Tween&) = delete;
+			Tween& operator=(const Tween&) = delete;
+			~Tween();
+
+			////////////////////////////////////////////////////////////
+			/// \brief Does the handle refer to a tween?
+			///
+			////////////////////////////////////////////////////////////
+			bool isActive() const;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Has a Repeat::Once tween reached its end value?
+			///
+			/// Repeating tweens never finish.
+			///
+			////////////////////////////////////////////////////////////
+			bool finished() const;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Go back to the start value
+			///
+			////////////////////////////////////////////////////////////
+			void restart();
+
+			////////////////////////////////////////////////////////////
+			/// \brief Jump to a point of the tween
+			///
+			/// For ping-pong tweens, 0-1 is the way there and 1-2 the
+			/// way back.
+			///
+			/// \param _progress The point to jump to, in durations
+			///
+			////////////////////////////////////////////////////////////
+			void setProgress(float _progress);
+
+			////////////////////////////////////////////////////////////
+			/// \brief Get the current value of a float tween
+			///
+			////////////////////////////////////////////////////////////
+			float getFloat() const;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Get the current value of a vector tween
+			///
+			////////////////////////////////////////////////////////////
+			sf::Vector2f getVector() const;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Get the current value of a color tween
+			///
+			////////////////////////////////////////////////////////////
+			sf::Color getColor() const;
+
+		  private:
+			friend class Animator;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Stop the tween, leaving the handle empty
+			///
+			////////////////////////////////////////////////////////////
+			void reset();
+
+			std::array<size_t, 4> m_tracks;   ///< The ids of the tween's tracks, one per component
+			size_t                m_channels; ///< The amount of components
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an animator with no tweens
+		///
+		////////////////////////////////////////////////////////////
+		Animator();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Start tweening a float
+		///
+		/// \param _from     The start value
+		/// \param _to       The end value
+		/// \param _duration The time it takes to go from start to end, in milliseconds
+		/// \param _easing   The curve to follow
+		/// \param _repeat   What to do once the end value is reached
+		///
+		////////////////////////////////////////////////////////////
+		Tween tween(float  _from,
+		            float  _to,
+		            float  _duration,
+		            Easing _easing = Easing::Linear,
+		            Repeat _repeat = Repeat::Once);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Start tweening a vector
+		///
+		/// \see tween(float, float, float, Easing, Repeat)
+		///
+		////////////////////////////////////////////////////////////
+		Tween tween(const sf::Vector2f& _from,
+		            const sf::Vector2f& _to,
+		            float               _duration,
+		            Easing              _easing = Easing::Linear,
+		            Repeat              _repeat = Repeat::Once);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Start tweening a color
+		///
+		/// \see tween(float, float, float, Easing, Repeat)
+		///
+		////////////////////////////////////////////////////////////
+		Tween tween(const sf::Color& _from,
+		            const sf::Color& _to,
+		            float            _duration,
+		            Easing           _easing = Easing::Linear,
+		            Repeat           _repeat = Repeat::Once);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Advance every tween
+		///
+		/// \param _timeslice The elapsed time, in milliseconds
+		///
+		////////////////////////////////////////////////////////////
+		void update(int _timeslice);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of running float tracks
+		///
+		////////////////////////////////////////////////////////////
+		size_t getTrackCount() const;
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief Start tweening the components of a value
+		///
+		////////////////////////////////////////////////////////////
+		Tween addTween(const float* _from,
+		               const float* _to,
+		               size_t       _channels,
+		               float        _duration,
+		               Easing       _easing,
+		               Repeat       _repeat);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a track, returning its id
+		///
+		////////////////////////////////////////////////////////////
+		size_t addTrack(float _from, float _to, float _duration, Easing _easing, Repeat _repeat);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Remove a track, moving the last one into its place
+		///
+		////////////////////////////////////////////////////////////
+		void removeTrack(size_t _id);
+
+		////////////////////////////////////////////////////////////
+		/// \brief How much each basic curve contributes to an easing curve
+		///
+		////////////////////////////////////////////////////////////
+		struct EasingWeights {
+			float linear;    ///< The weight of t
+			float quadratic; ///< The weight of t^2
+			float quadInOut; ///< The weight of the QuadInOut curve
+			float sineInOut; ///< The weight of the SineInOut curve
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the weights making up an easing curve
+		///
+		////////////////////////////////////////////////////////////
+		static EasingWeights getEasingWeights(Easing _easing);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Stop or wrap a track's elapsed time
+		///
+		/// \param _elapsed The elapsed time
+		/// \param _period  The time after which it wraps around
+		/// \param _limit   The time at which it stops
+		///
+		////////////////////////////////////////////////////////////
+		static float wrapTime(float _elapsed, float _period, float _limit);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the linear progress (0-1) of a track
+		///
+		/// Times up to one duration head towards the end value, and
+		/// times between one and two durations (for ping-pongs) head
+		/// back.
+		///
+		/// \param _cycles The wrapped elapsed time, in durations
+		///
+		////////////////////////////////////////////////////////////
+		static float linearProgress(float _cycles);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Apply an easing curve to a linear progress (0-1)
+		///
+		////////////////////////////////////////////////////////////
+		static float ease(float _t, float _linear, float _quadratic, float _quadInOut, float _sineInOut);
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		std::vector<float>  m_elapsed;         ///< The time each track has been running for, in milliseconds
+		std::vector<float>  m_duration;        ///< The duration of each track, in milliseconds
+		std::vector<float>  m_period;          ///< The time after which each track wraps around, in milliseconds
+		std::vector<float>  m_limit;           ///< The time at which each track stops, in milliseconds
+		std::vector<float>  m_from;            ///< The start value of each track
+		std::vector<float>  m_to;              ///< The end value of each track
+		std::vector<float>  m_progress;        ///< The eased progress (0-1) of each track
+		std::vector<float>  m_value;           ///< The current value of each track
+		std::vector<float>  m_linearWeight;    ///< The weight of t in each track's easing curve
+		std::vector<float>  m_quadraticWeight; ///< The weight of t^2 in each track's easing curve
+		std::vector<float>  m_quadInOutWeight; ///< The weight of QuadInOut in each track's easing curve
+		std::vector<float>  m_sineInOutWeight; ///< The weight of SineInOut in each track's easing curve
+		std::vector<Repeat> m_repeat;          ///< What each track does once it reaches its end value
+		std::vector<size_t> m_ids;             ///< The id of each track
+		std::vector<size_t> m_indices;         ///< The index in the arrays of each track id
+		std::vector<size_t> m_freeIds;         ///< The ids of removed tracks, to be reused
+	};
+
+} //namespace spss
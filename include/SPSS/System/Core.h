@@ -12,7 +12,10 @@
 /// of the penultimate state.
 ////////////////////////////////////////////////////////////////////
 
+#include <SPSS/System/Animator.h>
+#include <SPSS/System/InputSnapshot.h>
 #include <SPSS/System/State.h>
+#include <SPSS/System/TaskPool.h>
 #include <SPSS/Util/Singleton.h>
 #include <SFML/Graphics.hpp>
 
@@ -40,6 +43,9 @@ namespace spss {
 		/// getInput(), update(), and draw() functions of
 		/// the state currently at the top of the state stack
 		///
+		/// Every frame ends by running the completion callbacks of
+		/// any actions spss::TaskPool has finished.
+		///
 		////////////////////////////////////////////////////////////
 		virtual void run();
 
@@ -49,7 +55,8 @@ namespace spss {
 		/// In addition to calling getInput() for the current state
 		/// at the top of the stack, this function also checks if
 		/// the window has been closed and terminates the main loop
-		/// if so.
+		/// if so. Every event is fed to spss::InputSnapshot before
+		/// the states see it.
 		///
 		////////////////////////////////////////////////////////////
 		void getInput();
@@ -57,10 +64,10 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Update
 		///
-		/// Calls the update function for the state at the top of the
-		/// state stack. Also calls the penultimate state's update()
-		/// function if the state at the top of the stack is visible
-		/// over other states.
+		/// Advances spss::Animator, and then calls the update function
+		/// for the state at the top of the state stack. Also calls the
+		/// penultimate state's update() function if the state at the
+		/// top of the stack is visible over other states.
 		///
 		/// \param Timeslice value
 		///
@@ -99,7 +106,9 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		/// \brief Exits the loop
 		///
-		/// Closes m_window, which in turn ends the loop in run()
+		/// Closes m_window, which in turn ends the loop in run().
+		/// The shader animating MulticolorText effects is released
+		/// first, while the window's OpenGL context still exists.
 		///
 		////////////////////////////////////////////////////////////
 		void exit();
@@ -0,0 +1,156 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::InputSnapshot keeps track of the keyboard and mouse state,
+/// so that widgets don't have to ask the OS for it.
+///
+/// The snapshot is driven by events: spss::Core feeds it every
+/// event before passing the event on to the states, so by the time
+/// a widget sees an event, the snapshot already reflects it.
+/// Programs that don't use spss::Core should call handleEvent()
+/// themselves for every polled event.
+///
+/// Mapping the mouse position to a view's coordinates is cached,
+/// so it's computed at most once per view between mouse moves, no
+/// matter how many widgets ask for it. Only the last few views are
+/// remembered, so views that keep changing (scrolling, animated,
+/// ...) while the mouse is still don't pile up.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/Singleton.h>
+#include <SFML/Graphics.hpp>
+
+#include <array>
+#include <bitset>
+#include <initializer_list>
+
+namespace spss {
+
+	class InputSnapshot : public spss::Singleton<InputSnapshot> {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct a snapshot with nothing pressed
+		///
+		////////////////////////////////////////////////////////////
+		InputSnapshot();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update the snapshot with an event
+		///
+		/// Handling the same event more than once has no further
+		/// effect.
+		///
+		/// \param _event The polled event
+		///
+		////////////////////////////////////////////////////////////
+		void handleEvent(const sf::Event& _event);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Read the mouse position from the OS
+		///
+		/// Only needed once at startup, since the position is
+		/// otherwise kept up to date by mouse events.
+		///
+		/// \param _window The window the position is relative to
+		///
+		////////////////////////////////////////////////////////////
+		void sync(const sf::Window& _window);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is a key held down?
+		///
+		/// \param _key The key
+		///
+		////////////////////////////////////////////////////////////
+		bool isKeyPressed(sf::Keyboard::Key _key) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Are all of the keys held down?
+		///
+		/// \param _keys The keys
+		///
+		////////////////////////////////////////////////////////////
+		bool areKeysPressed(std::initializer_list<sf::Keyboard::Key> _keys) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is either CTRL key held down?
+		///
+		////////////////////////////////////////////////////////////
+		bool control() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is either SHIFT key held down?
+		///
+		////////////////////////////////////////////////////////////
+		bool shift() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is either ALT key held down?
+		///
+		////////////////////////////////////////////////////////////
+		bool alt() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is a mouse button held down?
+		///
+		/// \param _button The button
+		///
+		////////////////////////////////////////////////////////////
+		bool isButtonPressed(sf::Mouse::Button _button) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the mouse position, in pixels
+		///
+		////////////////////////////////////////////////////////////
+		const sf::Vector2i& getMousePixel() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the mouse position in a view's coordinates
+		///
+		/// The same as _target.mapPixelToCoords(getMousePixel(), _view),
+		/// but only computed once per view until the mouse moves.
+		///
+		/// \param _target The render target the view is used with
+		/// \param _view   The view
+		///
+		////////////////////////////////////////////////////////////
+		sf::Vector2f getMousePosition(const sf::RenderTarget& _target,
+		                              const sf::View&         _view) const;
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief The mouse position mapped through a view
+		///
+		////////////////////////////////////////////////////////////
+		struct MappedPosition {
+			const sf::RenderTarget* target;   ///< The render target the view is used with
+			sf::Vector2f            center;   ///< The view's center
+			sf::Vector2f            size;     ///< The view's size
+			float                   rotation; ///< The view's rotation
+			sf::FloatRect           viewport; ///< The view's viewport
+			sf::Vector2f            position; ///< The mapped mouse position
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the mouse position, discarding mapped positions if it changed
+		///
+		////////////////////////////////////////////////////////////
+		void setMousePixel(const sf::Vector2i& _pixel);
+
+		static constexpr size_t MAPPED_POSITION_CAPACITY{8};
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		std::bitset<sf::Keyboard::KeyCount>                          m_keys;            ///< The keys held down
+		std::bitset<sf::Mouse::ButtonCount>                          m_buttons;         ///< The mouse buttons held down
+		bool                                                         m_control;         ///< Is either CTRL key held down?
+		bool                                                         m_shift;           ///< Is either SHIFT key held down?
+		bool                                                         m_alt;             ///< Is either ALT key held down?
+		sf::Vector2i                                                 m_mousePixel;      ///< The mouse position, in pixels
+		mutable std::array<MappedPosition, MAPPED_POSITION_CAPACITY> m_mappedPositions; ///< The mouse position mapped through the last views asked for since it last moved
+		mutable size_t                                               m_mappedCount;     ///< How many of m_mappedPositions are in use
+		mutable size_t                                               m_nextMapped;      ///< The entry of m_mappedPositions to overwrite next once it's full
+	};
+
+} //namespace spss
@@ -14,20 +14,42 @@
 /// parameter (via std::bind). When this menu item is activated,
 /// either via clicking it or pressing  a specified keyboard shortcut,
 /// m_functionScope is used to call the function.
+///
+/// Menus with thousands of entries (save slots, server lists, etc.)
+/// can be given lightweight MenuRecords instead. Records are laid
+/// out below the menu items, but only the ones in view are given
+/// an sf::Text, taken from a small pool that is reused as the menu
+/// is scrolled. Records can also be loaded a page at a time, as
+/// the menu is scrolled towards the last one.
+///
+/// Menu items can also be made asynchronous, in which case their
+/// function is run on spss::TaskPool's worker threads, and the item
+/// is shown as busy (faded and unclickable) until it returns.
+///
+/// Since the menu items and records share a font and character
+/// size, they're batched into one vertex array per view, so drawing
+/// the menu takes the same amount of draw calls regardless of how
+/// many items it has. Menus whose items rarely change can go one
+/// step further and cache the items in render textures, so that
+/// scrolling them doesn't redraw the items at all.
 ////////////////////////////////////////////////////////////////////
 
+#include <SPSS/System/Animator.h>
 #include <SPSS/System/State.h>
+#include <SPSS/System/TaskPool.h>
 #include <SPSS/Graphics/Scrollbar.h>
+#include <SPSS/Graphics/TileCache.h>
 #include <SPSS/Util/Function.h>
 #include <SPSS/Util/Math.h>
 
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
-#include <any>
+#include <optional>
 #include <string>
 #include <random>
-#include <chrono>
+#include <unordered_map>
 
 namespace spss {
 
@@ -64,10 +86,20 @@ namespace spss {
 		/// Positions are specified this way so that they can be auto-
 		/// matically repositioned as needed upon window resizing.
 		///
+		/// Asynchronous items (async) run boundFunction on a worker
+		/// thread, and then onComplete on the main thread. task is
+		/// pending in the meantime.
+		///
+		/// While the item's highlight fades in or out, hover holds
+		/// how highlighted it is (0-1).
+		///
+		/// Lastly, firstVertex and vertexCount locate the item's
+		/// geometry in m_itemVertices or m_manualVertices.
+		///
 		////////////////////////////////////////////////////////////
 		struct MenuItem {
 			MenuItem(bool                _mousedOver,
-			         Function<std::any>  _boundFunction,
+			         Function<>          _boundFunction,
 			         sf::Text&           _text,
 			         int                 _keyCode,
 			         bool                _manualPos,
@@ -77,17 +109,71 @@ namespace spss {
 			              text{_text},
 			              keyCode{_keyCode},
 			              manualPos{_manualPos},
-			              ratioPos{_ratioPos} {};
-
-			bool               mousedOver;
-			Function<std::any> boundFunction;
-			sf::Text           text;
-			int                keyCode;
-			bool               manualPos;
-			sf::Vector2f       ratioPos;
+			              ratioPos{_ratioPos},
+			              async{false},
+			              onComplete{},
+			              task{},
+			              hover{},
+			              firstVertex{0},
+			              vertexCount{0} {};
+
+			bool            mousedOver;
+			Function<>      boundFunction;
+			sf::Text        text;
+			int             keyCode;
+			bool            manualPos;
+			sf::Vector2f    ratioPos;
+			bool            async;
+			Function<>      onComplete;
+			TaskPool::Task  task;
+			Animator::Tween hover;
+			mutable size_t  firstVertex;
+			mutable size_t  vertexCount;
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief The unscaled bounds of a clickable menu item
+		///
+		/// Auto-positioned items are kept sorted by the top of their
+		/// bounds, along with the greatest bottom of any item up to
+		/// and including them, so that the items containing a point
+		/// can be binary searched for.
+		///
+		////////////////////////////////////////////////////////////
+		struct ItemBounds {
+			sf::FloatRect bounds;    ///< The item's bounds, at a scale of 1
+			float         maxBottom; ///< The greatest bottom of this and all previous bounds
+			size_t        index;     ///< The item's index in m_menuItems
 		};
 
+		////////////////////////////////////////////////////////////
+		/// \brief A pooled text displaying one of the visible records
+		///
+		/// The record at index i is always displayed by the row at
+		/// index i % m_recordRows.size(), so scrolling by one record
+		/// only rebinds a single row.
+		///
+		////////////////////////////////////////////////////////////
+		struct RecordRow {
+			sf::Text        text;   ///< The text displaying the record
+			size_t          record; ///< The index of the displayed record, or NO_RECORD
+			Animator::Tween hover;  ///< How highlighted the row is (0-1), while it's fading in or out
+		};
+
+		static constexpr size_t NO_RECORD{size_t(-1)};
+
 	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief A lightweight, data-only menu entry
+		///
+		/// \see setMenuRecords
+		///
+		////////////////////////////////////////////////////////////
+		struct MenuRecord {
+			std::string label;    ///< The text displayed for the record, in UTF-8
+			Function<>  function; ///< The function called when the record is clicked, if any
+		};
+
 		////////////////////////////////////////////////////////////
 		/// \brief Construct the menu state
 		///
@@ -148,9 +234,9 @@ namespace spss {
 		///
 		////////////////////////////////////////////////////////////
 
-		void addMenuItem(const std::string&       _string,
-		                 spss::Function<std::any> f        = nullptr,
-		                 int                      _keyCode = sf::Keyboard::Unknown);
+		void addMenuItem(const std::string& _string,
+		                 spss::Function<>   f        = nullptr,
+		                 int                _keyCode = sf::Keyboard::Unknown);
 
 		////////////////////////////////////////////////////////////
 		/// \brief Add a clickable menu item
@@ -174,10 +260,36 @@ namespace spss {
 		/// \param _keyCode The keyboard shortcut to emulate a mouse click
 		///
 		////////////////////////////////////////////////////////////
-		void addMenuItem(const std::string&       _string,
-		                 const sf::Vector2f&      _pos,
-		                 spss::Function<std::any> f        = nullptr,
-		                 int                      _keyCode = sf::Keyboard::Unknown);
+		void addMenuItem(const std::string&  _string,
+		                 const sf::Vector2f& _pos,
+		                 spss::Function<>    f        = nullptr,
+		                 int                 _keyCode = sf::Keyboard::Unknown);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a menu item whose function runs in the background
+		///
+		/// Clicking the item dispatches its function to spss::TaskPool
+		/// rather than running it right away, so long actions (loading
+		/// a save, connecting to a server, ...) don't freeze the menu.
+		/// The item is faded and can't be clicked again until the
+		/// function returns, at which point _onComplete is called on
+		/// the main thread.
+		///
+		/// The function mustn't touch the menu or any other widget,
+		/// which is what _onComplete is for.
+		///
+		/// \param _string     The menu item's description
+		/// \param f           The function to run on a worker thread
+		/// \param _onComplete The function called once f returns
+		/// \param _keyCode    The keyboard shortcut to emulate a mouse click
+		///
+		/// \see addMenuItem
+		///
+		////////////////////////////////////////////////////////////
+		void addAsyncMenuItem(const std::string& _string,
+		                      spss::Function<>   f,
+		                      spss::Function<>   _onComplete = nullptr,
+		                      int                _keyCode    = sf::Keyboard::Unknown);
 
 		////////////////////////////////////////////////////////////
 		/// \brief Adds an empty line
@@ -189,12 +301,78 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void addGap();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Replace the menu's records
+		///
+		/// Records are laid out below the auto-positioned menu items
+		/// and scrolled along with them, but are only turned into
+		/// text while they're in view. Adding records is O(n) in
+		/// the amount of characters, and drawing them is O(1) in
+		/// the amount of records.
+		///
+		/// \param _records The records
+		///
+		////////////////////////////////////////////////////////////
+		void setMenuRecords(std::vector<MenuRecord> _records);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Append records after the existing ones
+		///
+		/// Unlike setMenuRecords, this doesn't scroll the menu back
+		/// to the top, so it's suited to loading a list a page at
+		/// a time.
+		///
+		/// \param _records The records to append
+		///
+		/// \see setRecordPrefetch
+		///
+		////////////////////////////////////////////////////////////
+		void addMenuRecords(std::vector<MenuRecord> _records);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the function asked for more records
+		///
+		/// The function is called once the menu is scrolled to
+		/// within _distance records of the last one (or right away,
+		/// if the records don't fill the menu), so that the next
+		/// page can be loaded before it's needed. It's then only
+		/// called again once more records have been added.
+		///
+		/// Loading can be dispatched to spss::TaskPool, with the
+		/// completion callback passing the page to addMenuRecords.
+		/// Adding no records stops the requests.
+		///
+		/// \param _distance  How many records ahead to load
+		/// \param _onNearEnd The function, or nullptr
+		///
+		////////////////////////////////////////////////////////////
+		void setRecordPrefetch(size_t _distance, Function<> _onNearEnd);
+
 		////////////////////////////////////////////////////////////
 		/// \brief Sets the scrollbar's color
 		///
 		////////////////////////////////////////////////////////////
 		void setScrollbarColor(sf::Color _c);
 
+		////////////////////////////////////////////////////////////
+		/// \brief Sets whether the auto-positioned items are cached
+		///
+		/// When enabled, the items are rendered into tiles (see
+		/// spss::TileCache) the first time they come into view,
+		/// and drawing the menu only draws the tiles in view, so
+		/// scrolling costs the same however many items there are.
+		/// Restyling an item (e.g. when it's moused over) only
+		/// renders the tiles it's in again.
+		///
+		/// Worth it for long menus that rarely change, such as
+		/// help text or credits. Records are always drawn as they
+		/// are, since only the ones in view are drawn anyway.
+		///
+		/// \param _b The boolean value
+		///
+		////////////////////////////////////////////////////////////
+		void setScrollCaching(bool _b);
+
 	  private:
 		////////////////////////////////////////////////////////////
 		/// \brief Resets both m_view and m_backgroundView
@@ -233,6 +411,45 @@ namespace spss {
 		////////////////////////////////////////////////////////////
 		void adjustMenuItems();
 
+		////////////////////////////////////////////////////////////
+		/// \brief Positions a single menu item
+		///
+		/// Auto-positioned items are placed at m_nextItemY, which
+		/// is then advanced, and m_itemsWidth is updated.
+		///
+		/// \param _menuItem The menu item to position
+		///
+		////////////////////////////////////////////////////////////
+		void layoutMenuItem(MenuItem& _menuItem);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Lays out a menu item that was just added
+		///
+		/// Only the new item is positioned and indexed, and the
+		/// rest of the layout only depends on the cached metrics
+		/// (m_nextItemY, m_itemsWidth), so adding n items is O(n)
+		/// rather than O(n^2).
+		///
+		////////////////////////////////////////////////////////////
+		void layoutLastMenuItem();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Lays out everything around the menu items
+		///
+		/// Adjusts the viewport, the title and the scrollbar, none
+		/// of which need to look at each menu item.
+		///
+		////////////////////////////////////////////////////////////
+		void adjustFrame();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Lays out the whole menu for the current window size
+		///
+		/// Same as onResize, without resizing the window.
+		///
+		////////////////////////////////////////////////////////////
+		void updateLayout();
+
 		////////////////////////////////////////////////////////////
 		/// \brief Centers the title text and menu items
 		///
@@ -249,20 +466,173 @@ namespace spss {
 		void adjustBoundaries();
 
 		////////////////////////////////////////////////////////////
-		/// \brief Detects mouseclicks
+		/// \brief Detects mouseovers
 		///
-		/// Detects mouseclicks and mouseovers
+		/// Only the items that gained or lost the mouse since the
+		/// last call are restyled, so nothing is touched while the
+		/// mouse stays on the same item.
 		///
 		////////////////////////////////////////////////////////////
 		void detectMouseClicks();
 
 		////////////////////////////////////////////////////////////
-		/// \brief Update the title text
+		/// \brief Call a menu item's function, or dispatch it if async
 		///
-		/// Randomises title color, scale, and rotation if these
-		/// options have been enabled.
+		/// Busy items are ignored.
 		///
-		/// \param _timeslice The timeslice value
+		/// \param _index The menu item's index in m_menuItems
+		///
+		////////////////////////////////////////////////////////////
+		void activateMenuItem(size_t _index);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Restyle the busy menu items that have finished
+		///
+		////////////////////////////////////////////////////////////
+		void updateBusyItems();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Restyle the menu items and rows whose highlight is fading
+		///
+		/// Items and rows are dropped once their fade is over, so
+		/// nothing is restyled while the mouse is still.
+		///
+		////////////////////////////////////////////////////////////
+		void updateHoverFades();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Start fading a highlight in or out
+		///
+		/// The fade starts from wherever the last one left off.
+		///
+		/// \param _hover   The tween to start
+		/// \param _hovered Is the highlight fading in?
+		///
+		////////////////////////////////////////////////////////////
+		static void fadeHover(Animator::Tween& _hover, bool _hovered);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get how highlighted something is (0-1)
+		///
+		/// \param _hover   The tween of its fade, which may be empty
+		/// \param _hovered Is it being moused over?
+		///
+		////////////////////////////////////////////////////////////
+		static float getHoverProgress(const Animator::Tween& _hover, bool _hovered);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Style a menu item according to its hover state
+		///
+		/// Hovered items are highlighted and scaled up, as far as
+		/// their highlight has faded in, while items that don't do
+		/// anything when clicked, or are busy, are faded.
+		///
+		/// \param _menuItem The menu item to style
+		///
+		////////////////////////////////////////////////////////////
+		void applyItemStyle(MenuItem& _menuItem);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Rebuild any outdated menu item or record geometry
+		///
+		/// Called before drawing. The menu items are only rebuilt
+		/// after they've been laid out again, since restyling an
+		/// item updates its geometry in place.
+		///
+		////////////////////////////////////////////////////////////
+		void ensureGeometryUpdate() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Append a menu item's geometry to its vertex array
+		///
+		/// Does nothing if the vertex arrays are about to be rebuilt
+		/// anyway.
+		///
+		/// \param _menuItem The menu item
+		///
+		////////////////////////////////////////////////////////////
+		void appendItemVertices(const MenuItem& _menuItem) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Rewrite a restyled menu item's geometry in place
+		///
+		/// Restyling doesn't change the item's string, so it keeps
+		/// the same amount of vertices and nothing else is touched.
+		///
+		/// \param _menuItem The menu item
+		///
+		////////////////////////////////////////////////////////////
+		void updateItemVertices(const MenuItem& _menuItem);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Invalidate the cached tiles a range of m_itemVertices is in
+		///
+		/// \param _first The index of the first vertex
+		/// \param _count The amount of vertices
+		///
+		////////////////////////////////////////////////////////////
+		void invalidateItemTiles(size_t _first, size_t _count) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Lay out the records and reset the row pool
+		///
+		/// \param _top The y coordinate of the first record in m_view
+		///
+		////////////////////////////////////////////////////////////
+		void layoutRecords(float _top);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Bind the records in view to the row pool
+		///
+		/// Does nothing unless the menu has been scrolled by at
+		/// least one record since the last call, and then only the
+		/// rows whose record changed are rebound.
+		///
+		/// \param _force Rebind every row, even if not scrolled
+		///
+		////////////////////////////////////////////////////////////
+		void updateVisibleRecords(bool _force = false);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Ask for more records if they're about to run out
+		///
+		/// \param _bottom The lowest y coordinate in m_view that needs content
+		///
+		////////////////////////////////////////////////////////////
+		void checkRecordPrefetch(float _bottom);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Style a record row according to its hover state
+		///
+		/// \param _row The row to style
+		///
+		////////////////////////////////////////////////////////////
+		void applyRowStyle(RecordRow& _row);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Find the clickable record being moused over
+		///
+		/// Since records are evenly spaced, this is O(1).
+		///
+		////////////////////////////////////////////////////////////
+		std::optional<size_t> findMousedOverRecord() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Measure the width of a record's label
+		///
+		/// Sums up the glyph advances, which is much cheaper than
+		/// laying out an sf::Text.
+		///
+		/// \param _label The label, in UTF-8
+		///
+		////////////////////////////////////////////////////////////
+		float measureLabel(const std::string& _label) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Update the title text
+		///
+		/// Randomises title color, and applies the title's scale and
+		/// rotation tweens, if these options have been enabled.
 		///
 		///
 		/// \see setRandomisedColors
@@ -270,15 +640,42 @@ namespace spss {
 		/// \see setRotatingText
 		///
 		////////////////////////////////////////////////////////////
-		void updateTitleText(int _timeslice);
+		void updateTitleText();
 
 		////////////////////////////////////////////////////////////
-		/// \brief Checks if a menu item is being moused over
+		/// \brief Find the clickable menu item being moused over
 		///
-		/// \param _menuItem The menu item to check
+		/// Manually positioned items are checked first, since
+		/// they're drawn on top. Auto-positioned items are binary
+		/// searched for in m_autoBounds, so this is O(log n).
+		///
+		/// \see indexMenuItem
+		///
+		////////////////////////////////////////////////////////////
+		std::optional<size_t> findMousedOverItem() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add a laid out menu item to m_autoBounds or m_manualBounds
+		///
+		/// Auto-positioned items have to be indexed in the order
+		/// they're laid out in.
+		///
+		/// \param _index The menu item's index in m_menuItems
+		///
+		////////////////////////////////////////////////////////////
+		void indexMenuItem(size_t _index);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get a text's bounds as if it wasn't scaled
+		///
+		/// Hovered items are scaled up, so using their unscaled
+		/// bounds prevents them from flickering when the mouse is
+		/// near their edge.
+		///
+		/// \param _text The menu item's or record row's text
 		///
 		////////////////////////////////////////////////////////////
-		bool isMousedOver(const MenuItem& _menuItem) const;
+		sf::FloatRect getUnscaledBounds(const sf::Text& _text) const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Checks if a menu item's bound function is null
@@ -420,23 +817,51 @@ namespace spss {
 		///////////////////////////////////////////////////////////
 
 	  private:
-		const sf::Font&       m_font;                  ///< Font used to display the title and menu items
-		std::vector<MenuItem> m_menuItems;             ///< The menu items
-		sf::View              m_view;                  ///< The view used to draw the menu items
-		sf::View              m_backgroundView;        ///< The view used to draw the title text
-		sf::Text              m_titleText;             ///< The title text
-		bool                  m_titleAutoPos;          ///< If false, the title will always be at the very top to save space
-		spss::Scrollbar       m_scrollbar;             ///< The scrollbar
-		bool                  m_randomiseTextColor;    ///< Is the title's color randomised?
-		int                   m_randomColorDurationMS; ///< How many MS the title's color persists for before it is randomised again
-		bool                  m_scaleText;             ///< Is the title being scaled up and down?
-		float                 m_minScale;              ///< The title text's minimum possible scaling value
-		float                 m_maxScale;              ///< The title text's maximum possible scaling value
-		bool                  m_rotateText;            ///< Is the title text being rotated?
-		float                 m_rotationDegrees;       ///< The title text's maximum rotation in degrees
-		sf::Color             m_highlightColor;        ///< The color of highlighted menu items
-		float                 m_highlightScale;        ///< The scaling value for highlighted menu items
-		                                               //---------------------------------------------
+		const sf::Font&                 m_font;                   ///< Font used to display the title and menu items
+		std::vector<MenuItem>           m_menuItems;              ///< The menu items
+		std::vector<ItemBounds>         m_autoBounds;             ///< The bounds of the clickable auto-positioned menu items, sorted by top
+		std::vector<ItemBounds>         m_manualBounds;           ///< The bounds of the clickable manually positioned menu items
+		std::unordered_map<int, size_t> m_shortcuts;              ///< The index of the clickable menu item bound to each keyboard shortcut
+		sf::View                        m_view;                   ///< The view used to draw the menu items
+		sf::View                        m_backgroundView;         ///< The view used to draw the title text
+		sf::Text                        m_titleText;              ///< The title text
+		bool                            m_titleAutoPos;           ///< If false, the title will always be at the very top to save space
+		spss::Scrollbar                 m_scrollbar;              ///< The scrollbar
+		int                             m_randomColorDurationMS;  ///< How many MS the title's color persists for before it is randomised again
+		float                           m_minScale;               ///< The title text's minimum possible scaling value
+		float                           m_maxScale;               ///< The title text's maximum possible scaling value
+		float                           m_rotationDegrees;        ///< The title text's maximum rotation in degrees
+		Animator::Tween                 m_colorTimer;             ///< Runs out whenever the title's color is to be randomised, if enabled
+		Animator::Tween                 m_rotationTween;          ///< The title text's rotation, if enabled
+		Animator::Tween                 m_scaleTween;             ///< The title text's scale, if enabled
+		std::mt19937                    m_random;                 ///< Used to randomise the title's color
+		sf::Color                       m_highlightColor;         ///< The color of highlighted menu items
+		float                           m_highlightScale;         ///< The scaling value for highlighted menu items
+		sf::Color                       m_itemColor;              ///< The color of menu items that aren't highlighted
+		std::optional<size_t>           m_hoveredItem;            ///< The index of the menu item being moused over, if any
+		std::vector<size_t>             m_busyItems;              ///< The indices of the async menu items whose function is running
+		std::vector<size_t>             m_fadingItems;            ///< The indices of the menu items whose highlight is fading in or out
+		float                           m_nextItemY;              ///< The y coordinate at which the next auto-positioned item goes in m_view
+		float                           m_itemsWidth;             ///< The width of the widest auto-positioned item, unscaled
+		std::vector<MenuRecord>         m_records;                ///< The menu records
+		std::vector<RecordRow>          m_recordRows;             ///< The pooled texts displaying the records in view
+		unsigned int                    m_itemCharSize;           ///< The character size of the menu items and records
+		float                           m_recordsTop;             ///< The y coordinate of the first record in m_view
+		float                           m_recordHeight;           ///< The vertical distance between two records
+		float                           m_recordsWidth;           ///< The width of the widest record's label
+		size_t                          m_firstVisibleRecord;     ///< The index of the first record bound to a row
+		std::optional<size_t>           m_hoveredRecord;          ///< The index of the record being moused over, if any
+		Function<>                      m_onRecordsNearEnd;       ///< Asked for more records once the last ones are near
+		float                           m_recordPrefetchDistance; ///< How far ahead of the view to load records, in pixels
+		size_t                          m_prefetchedRecordCount;  ///< The amount of records when more were last asked for, or NO_RECORD
+		mutable sf::VertexArray         m_itemVertices;           ///< The geometry of the auto-positioned menu items, drawn in m_view
+		mutable sf::VertexArray         m_manualVertices;         ///< The geometry of the manually positioned menu items, drawn in m_backgroundView
+		mutable sf::VertexArray         m_rowVertices;            ///< The geometry of the bound record rows, drawn in m_view
+		mutable bool                    m_itemVerticesNeedUpdate; ///< Do the menu items need to be laid out in the vertex arrays again?
+		mutable bool                    m_rowVerticesNeedUpdate;  ///< Have any record rows been rebound or restyled?
+		mutable spss::TileCache         m_itemCache;              ///< The rendered auto-positioned items, if scroll caching is enabled
+		bool                            m_scrollCaching;          ///< Are the auto-positioned items drawn from m_itemCache?
+		                                                          //---------------------------------------------
 	};
 
 } //namespace spss
@@ -0,0 +1,164 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::TaskPool runs long actions (loading a save, connecting to
+/// a server, ...) on worker threads, so that they don't freeze the
+/// window.
+///
+/// dispatch() queues an action and returns a TaskPool::Task, a
+/// handle through which the caller can tell whether it's still
+/// running. Once the action returns, its completion callback is
+/// queued up for the main thread, and spss::Core runs the queued
+/// callbacks at the end of every frame, so they can safely touch
+/// states and widgets. Programs that don't use spss::Core should
+/// call runContinuations() once per frame themselves. A callback
+/// that takes an std::exception_ptr is passed the exception the
+/// action threw, or nullptr if it returned normally.
+///
+/// Destroying a handle only discards the completion callback; the
+/// action itself still runs to completion, so it mustn't refer to
+/// anything that may be destroyed in the meantime.
+///
+/// The worker threads are only started by the first dispatch().
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/Function.h>
+#include <SPSS/Util/Singleton.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spss {
+
+	class TaskPool : public spss::Singleton<TaskPool> {
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief The state shared between a task and its handle
+		///
+		/// action and error are only touched by the worker running
+		/// the task until it's handed back to the main thread, and
+		/// the rest only by the main thread.
+		///
+		////////////////////////////////////////////////////////////
+		struct TaskState {
+			Function<>                   action;     ///< The action to run on a worker thread
+			Function<>                   onComplete; ///< Called on the main thread once the action returns
+			Function<std::exception_ptr> onResult;   ///< Called with error instead of onComplete, if set
+			std::exception_ptr           error;      ///< The exception thrown by the action, if any
+			bool                         finished;   ///< Has the completion callback been run (or discarded)?
+			bool                         detached;   ///< Has the handle been destroyed?
+		};
+
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief A handle to a dispatched action
+		///
+		/// Move-only. A default constructed handle doesn't refer to
+		/// any action.
+		///
+		////////////////////////////////////////////////////////////
+		class Task {
+		  public:
+			Task();
+			Task(Task&& _other) noexcept;
+			Task& operator=(Task&& _other) noexcept;
+			Task(const Task&) = delete;
+			Task& operator=(const Task&) = delete;
+			~Task();
+
+			////////////////////////////////////////////////////////////
+			/// \brief Is the action running, or waiting to run?
+			///
+			/// Stays true until the completion callback has been run
+			/// on the main thread.
+			///
+			////////////////////////////////////////////////////////////
+			bool isPending() const;
+
+			////////////////////////////////////////////////////////////
+			/// \brief Get the exception the action threw, if any
+			///
+			/// Only meaningful once the task is no longer pending.
+			///
+			////////////////////////////////////////////////////////////
+			std::exception_ptr getError() const;
+
+		  private:
+			friend class TaskPool;
+
+			std::shared_ptr<TaskState> m_state; ///< The task's state, or nullptr
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct a pool without starting any threads
+		///
+		////////////////////////////////////////////////////////////
+		TaskPool();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Finish every queued action and join the threads
+		///
+		////////////////////////////////////////////////////////////
+		~TaskPool();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Run an action on a worker thread
+		///
+		/// \param _action     The action to run
+		/// \param _onComplete Called on the main thread once the action returns
+		///
+		////////////////////////////////////////////////////////////
+		Task dispatch(Function<> _action, Function<> _onComplete = nullptr);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Run an action on a worker thread
+		///
+		/// \param _action   The action to run
+		/// \param _onResult Called on the main thread once the action returns,
+		///                  with the exception it threw or nullptr
+		///
+		////////////////////////////////////////////////////////////
+		Task dispatch(Function<> _action, Function<std::exception_ptr> _onResult);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Run the completion callbacks of finished actions
+		///
+		/// Has to be called from the main thread. If a callback
+		/// throws, the exception is passed on, and the callbacks
+		/// that haven't been run yet are left for the next call.
+		///
+		////////////////////////////////////////////////////////////
+		void runContinuations();
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief Queue a task for the worker threads
+		///
+		/// The threads are started if they haven't been yet.
+		///
+		////////////////////////////////////////////////////////////
+		void queue(const std::shared_ptr<TaskState>& _state);
+
+		////////////////////////////////////////////////////////////
+		/// \brief Run queued actions until the pool is destroyed
+		///
+		////////////////////////////////////////////////////////////
+		void work();
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		std::vector<std::thread>                m_threads;   ///< The worker threads
+		std::deque<std::shared_ptr<TaskState>>  m_queue;     ///< The actions waiting for a worker
+		std::vector<std::shared_ptr<TaskState>> m_completed; ///< The actions waiting for their completion callback
+		std::mutex                              m_mutex;     ///< Guards m_queue, m_completed and m_stopping
+		std::condition_variable                 m_condition; ///< Signalled when an action is queued or the pool stops
+		bool                                    m_stopping;  ///< Is the pool being destroyed?
+	};
+
+} //namespace spss
@@ -0,0 +1,34 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::CompletionProvider is the interface for anything that can
+/// suggest completions for a prefix, such as spss::PrefixIndex.
+///
+/// Text entry widgets query their provider whenever the word at
+/// the caret changes, so implementations should answer quickly and
+/// without blocking.
+////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+namespace spss {
+
+	class CompletionProvider {
+	  public:
+		virtual ~CompletionProvider() = default;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Find completions for a prefix
+		///
+		/// \param _prefix The prefix, encoded in UTF-8
+		/// \param _max    The maximum amount of completions to find
+		/// \param _out    The vector the completions are appended to
+		///
+		////////////////////////////////////////////////////////////
+		virtual void complete(const std::string&        _prefix,
+		                      size_t                    _max,
+		                      std::vector<std::string>& _out) const = 0;
+	};
+
+} //namespace spss
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
 #include <SFML/System/Vector2.hpp>
 
 ////////////////////////////////////////////////////////////////////
@@ -49,4 +51,25 @@ namespace spss::Util::Coordinates {
 		return false;
 	}
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the viewport that covers exactly an area
+	///
+	/// Maps the area to the target's normalized coordinates through
+	/// the view it's drawn with. A view given this viewport draws
+	/// only inside the area, which is useful for clipping.
+	///
+	/// \param _view   The view the area is drawn with
+	/// \param _bounds The area, in the view's coordinates
+	///
+	////////////////////////////////////////////////////////////
+	inline sf::FloatRect getViewportCovering(const sf::View& _view, const sf::FloatRect& _bounds) {
+		auto         viewport{_view.getViewport()};
+		sf::Vector2f viewTopLeft{_view.getCenter() - _view.getSize() / 2.f};
+
+		return {viewport.left + (_bounds.left - viewTopLeft.x) / _view.getSize().x * viewport.width,
+		        viewport.top + (_bounds.top - viewTopLeft.y) / _view.getSize().y * viewport.height,
+		        _bounds.width / _view.getSize().x * viewport.width,
+		        _bounds.height / _view.getSize().y * viewport.height};
+	}
+
 } // namespace spss::Util::Coordinates
@@ -0,0 +1,267 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::EditHistory is an undo/redo history for editable text.
+///
+/// Rather than snapshots of the whole text, each entry only stores
+/// the position of an edit along with the characters it removed
+/// and inserted, so undoing or redoing an edit is O(edit size).
+/// Consecutive keystrokes (typing, backspacing or deleting at
+/// adjacent positions) are merged into a single entry, and the
+/// oldest entries are discarded once the history uses more memory
+/// than its cap.
+////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace spss {
+
+	template<typename CharType>
+	class EditHistory {
+	  public:
+		using String = std::basic_string<CharType>;
+
+		////////////////////////////////////////////////////////////
+		/// \brief A single edit
+		///
+		/// Undoing it means erasing inserted.size() characters at
+		/// pos and inserting removed in their place, and redoing it
+		/// means the opposite.
+		///
+		////////////////////////////////////////////////////////////
+		struct Edit {
+			size_t pos;      ///< The position at which the edit was made
+			String removed;  ///< The characters the edit removed
+			String inserted; ///< The characters the edit inserted
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty history
+		///
+		/// \param _memoryCap The maximum amount of bytes to use
+		///
+		////////////////////////////////////////////////////////////
+		explicit EditHistory(size_t _memoryCap = 1 << 20)
+		            : m_undo{}, m_redo{}, m_memoryCap{_memoryCap}, m_memoryUsage{0}, m_sealed{true} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the maximum amount of bytes to use
+		///
+		/// The oldest entries are discarded until the history fits.
+		///
+		/// \param _memoryCap The maximum amount of bytes to use
+		///
+		////////////////////////////////////////////////////////////
+		void setMemoryCap(size_t _memoryCap) {
+			m_memoryCap = _memoryCap;
+			enforceMemoryCap();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of bytes currently in use
+		///
+		////////////////////////////////////////////////////////////
+		size_t getMemoryUsage() const {
+			return m_memoryUsage;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Can an edit be undone?
+		///
+		////////////////////////////////////////////////////////////
+		bool canUndo() const {
+			return !m_undo.empty();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Can an edit be redone?
+		///
+		////////////////////////////////////////////////////////////
+		bool canRedo() const {
+			return !m_redo.empty();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Discard all entries
+		///
+		////////////////////////////////////////////////////////////
+		void clear() {
+			m_undo.clear();
+			m_redo.clear();
+			m_memoryUsage = 0;
+			m_sealed      = true;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Prevent the next edit from being merged
+		///
+		/// Should be called whenever the caret is moved by other
+		/// means than editing.
+		///
+		////////////////////////////////////////////////////////////
+		void seal() {
+			m_sealed = true;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Record an edit
+		///
+		/// The edit is merged into the last one if they're both
+		/// single keystrokes at adjacent positions. Edits of more
+		/// than one character, such as pastes, always get their
+		/// own entry. Any edits that could've been redone are
+		/// discarded.
+		///
+		/// \param _pos      The position at which the edit was made
+		/// \param _removed  The characters the edit removed
+		/// \param _inserted The characters the edit inserted
+		///
+		////////////////////////////////////////////////////////////
+		void record(size_t _pos, String _removed, String _inserted) {
+			if (_removed.empty() && _inserted.empty()) {
+				return;
+			}
+
+			for (const auto& edit : m_redo) {
+				m_memoryUsage -= memoryUsage(edit);
+			}
+			m_redo.clear();
+
+			bool keystroke{_removed.size() + _inserted.size() == 1};
+
+			if (!merge(_pos, _removed, _inserted)) {
+				m_undo.push_back({_pos, std::move(_removed), std::move(_inserted)});
+				m_memoryUsage += memoryUsage(m_undo.back());
+			}
+
+			//Only entries made of keystrokes can be merged into
+			m_sealed = !keystroke;
+			enforceMemoryCap();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move the last edit to the redo stack
+		///
+		/// Returns the edit, which the caller has to revert, or
+		/// nullptr if there's nothing to undo. The pointer stays
+		/// valid until the history is modified.
+		///
+		////////////////////////////////////////////////////////////
+		const Edit* undo() {
+			if (m_undo.empty()) {
+				return nullptr;
+			}
+
+			m_redo.push_back(std::move(m_undo.back()));
+			m_undo.pop_back();
+			m_sealed = true;
+			return &m_redo.back();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move the last undone edit back to the undo stack
+		///
+		/// Returns the edit, which the caller has to reapply, or
+		/// nullptr if there's nothing to redo. The pointer stays
+		/// valid until the history is modified.
+		///
+		////////////////////////////////////////////////////////////
+		const Edit* redo() {
+			if (m_redo.empty()) {
+				return nullptr;
+			}
+
+			m_undo.push_back(std::move(m_redo.back()));
+			m_redo.pop_back();
+			m_sealed = true;
+			return &m_undo.back();
+		}
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief Try to merge a keystroke into the last edit
+		///
+		/// Typing is merged until a word is completed, while
+		/// backspacing and deleting are merged regardless. Since
+		/// any other edit seals the history, the last edit is
+		/// known to be made of keystrokes if it isn't sealed.
+		///
+		////////////////////////////////////////////////////////////
+		bool merge(size_t _pos, const String& _removed, const String& _inserted) {
+			if (m_sealed || m_undo.empty() || _removed.size() + _inserted.size() != 1) {
+				return false;
+			}
+
+			Edit& last{m_undo.back()};
+
+			//Typing over the last erased characters
+			if (_removed.empty() && last.inserted.empty() && _pos == last.pos) {
+				last.inserted = _inserted;
+			}
+
+			//Typing right after the last typed character
+			else if (_removed.empty() && !last.inserted.empty() &&
+			         _pos == last.pos + last.inserted.size() &&
+			         !(last.inserted.back() == CharType(' ') && _inserted[0] != CharType(' '))) {
+				last.inserted += _inserted;
+			}
+
+			//Backspacing right before the last erased character
+			else if (_inserted.empty() && last.inserted.empty() && _pos + 1 == last.pos) {
+				last.removed.insert(last.removed.begin(), _removed[0]);
+				last.pos = _pos;
+			}
+
+			//Deleting right after the last erased character
+			else if (_inserted.empty() && last.inserted.empty() && _pos == last.pos) {
+				last.removed += _removed;
+			}
+
+			else {
+				return false;
+			}
+
+			m_memoryUsage += sizeof(CharType);
+			return true;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Discard the oldest entries until the cap is met
+		///
+		/// The redo stack is only discarded if the undo stack is
+		/// already empty.
+		///
+		////////////////////////////////////////////////////////////
+		void enforceMemoryCap() {
+			while (m_memoryUsage > m_memoryCap && !m_undo.empty()) {
+				m_memoryUsage -= memoryUsage(m_undo.front());
+				m_undo.pop_front();
+			}
+			while (m_memoryUsage > m_memoryCap && !m_redo.empty()) {
+				m_memoryUsage -= memoryUsage(m_redo.front());
+				m_redo.erase(m_redo.begin());
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of bytes an edit accounts for
+		///
+		////////////////////////////////////////////////////////////
+		static size_t memoryUsage(const Edit& _edit) {
+			return sizeof(Edit) + (_edit.removed.size() + _edit.inserted.size()) * sizeof(CharType);
+		}
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		std::deque<Edit>  m_undo;        ///< The edits that can be undone, oldest first
+		std::vector<Edit> m_redo;        ///< The edits that can be redone, next one last
+		size_t            m_memoryCap;   ///< The maximum amount of bytes to use
+		size_t            m_memoryUsage; ///< The amount of bytes currently in use
+		bool              m_sealed;      ///< Should the next edit start a new entry?
+	};
+
+} //namespace spss
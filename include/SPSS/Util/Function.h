@@ -2,16 +2,224 @@
 
 ////////////////////////////////////////////////////////////
 ///
-/// spss::Function will simply serve as an alias for
-/// a std::function with a void return type and any
+/// spss::InplaceFunction is a std::function that never
+/// allocates: callables are stored in a fixed size buffer
+/// inside the object, and one that doesn't fit is a compile
+/// time error rather than a heap allocation.
+///
+/// spss::Function will simply serve as an alias for an
+/// InplaceFunction with a void return type and any
 /// possible number of arguments
 ///
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace spss {
 
+	////////////////////////////////////////////////////////////
+	/// The default buffer size, which fits a std::bind of a
+	/// member function and a few arguments, or a lambda
+	/// capturing a few pointers or a std::string
+	////////////////////////////////////////////////////////////
+	constexpr size_t DEFAULT_FUNCTION_CAPACITY{48};
+
+	template<typename Signature, size_t Capacity = DEFAULT_FUNCTION_CAPACITY>
+	class InplaceFunction;
+
+	template<typename R, typename... Args, size_t Capacity>
+	class InplaceFunction<R(Args...), Capacity> {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty function
+		///
+		////////////////////////////////////////////////////////////
+		InplaceFunction() noexcept
+		            : m_ops{nullptr} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty function
+		///
+		////////////////////////////////////////////////////////////
+		InplaceFunction(std::nullptr_t) noexcept
+		            : m_ops{nullptr} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Store a callable
+		///
+		/// The callable has to be copyable and fit in the buffer.
+		/// A null function pointer leaves the function empty.
+		///
+		/// \param _callable The callable
+		///
+		////////////////////////////////////////////////////////////
+		template<typename F,
+		         typename T = std::decay_t<F>,
+		         typename   = std::enable_if_t<!std::is_same_v<T, InplaceFunction> &&
+		                                     std::is_invocable_r_v<R, T&, Args...>>>
+		InplaceFunction(F&& _callable)
+		            : m_ops{nullptr} {
+			static_assert(sizeof(T) <= Capacity,
+			              "The callable doesn't fit in the spss::InplaceFunction, increase its capacity");
+			static_assert(alignof(T) <= alignof(std::max_align_t),
+			              "The callable is over-aligned for spss::InplaceFunction");
+			static_assert(std::is_copy_constructible_v<T>,
+			              "spss::InplaceFunction can only store copyable callables");
+
+			if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+				if (_callable == nullptr) {
+					return;
+				}
+			}
+
+			::new (static_cast<void*>(m_storage)) T(std::forward<F>(_callable));
+			m_ops = &OPS<T>;
+		}
+
+		InplaceFunction(const InplaceFunction& _other)
+		            : m_ops{_other.m_ops} {
+			if (m_ops != nullptr) {
+				m_ops->copy(m_storage, _other.m_storage);
+			}
+		}
+
+		InplaceFunction(InplaceFunction&& _other) noexcept
+		            : m_ops{_other.m_ops} {
+			if (m_ops != nullptr) {
+				m_ops->move(m_storage, _other.m_storage);
+				_other.reset();
+			}
+		}
+
+		InplaceFunction& operator=(const InplaceFunction& _other) {
+			if (this != &_other) {
+				reset();
+				if (_other.m_ops != nullptr) {
+					_other.m_ops->copy(m_storage, _other.m_storage);
+					m_ops = _other.m_ops;
+				}
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(InplaceFunction&& _other) noexcept {
+			if (this != &_other) {
+				reset();
+				if (_other.m_ops != nullptr) {
+					_other.m_ops->move(m_storage, _other.m_storage);
+					m_ops = _other.m_ops;
+					_other.reset();
+				}
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+
+		~InplaceFunction() {
+			reset();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Call the stored callable
+		///
+		/// Throws std::bad_function_call if the function is empty,
+		/// just like std::function.
+		///
+		////////////////////////////////////////////////////////////
+		R operator()(Args... _args) const {
+			if (m_ops == nullptr) {
+				throw std::bad_function_call();
+			}
+			return m_ops->invoke(m_storage, std::forward<Args>(_args)...);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Does the function store a callable?
+		///
+		////////////////////////////////////////////////////////////
+		explicit operator bool() const noexcept {
+			return m_ops != nullptr;
+		}
+
+		friend bool operator==(const InplaceFunction& _f, std::nullptr_t) noexcept {
+			return !_f;
+		}
+
+		friend bool operator==(std::nullptr_t, const InplaceFunction& _f) noexcept {
+			return !_f;
+		}
+
+		friend bool operator!=(const InplaceFunction& _f, std::nullptr_t) noexcept {
+			return bool(_f);
+		}
+
+		friend bool operator!=(std::nullptr_t, const InplaceFunction& _f) noexcept {
+			return bool(_f);
+		}
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief The operations on a stored callable's type
+		///
+		/// One table exists per callable type, so a function only
+		/// needs a single pointer to know what it's storing.
+		///
+		////////////////////////////////////////////////////////////
+		struct Ops {
+			R (*invoke)(void*, Args&&...);
+			void (*copy)(void*, const void*);
+			void (*move)(void*, void*) noexcept;
+			void (*destroy)(void*) noexcept;
+		};
+
+		template<typename T>
+		static constexpr Ops OPS{
+		  [](void* _callable, Args&&... _args) -> R {
+			  if constexpr (std::is_void_v<R>) {
+				  std::invoke(*static_cast<T*>(_callable), std::forward<Args>(_args)...);
+			  }
+			  else {
+				  return std::invoke(*static_cast<T*>(_callable), std::forward<Args>(_args)...);
+			  }
+		  },
+		  [](void* _dest, const void* _source) {
+			  ::new (_dest) T(*static_cast<const T*>(_source));
+		  },
+		  [](void* _dest, void* _source) noexcept {
+			  ::new (_dest) T(std::move(*static_cast<T*>(_source)));
+		  },
+		  [](void* _callable) noexcept {
+			  static_cast<T*>(_callable)->~T();
+		  }};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Destroy the stored callable, if any
+		///
+		////////////////////////////////////////////////////////////
+		void reset() noexcept {
+			if (m_ops != nullptr) {
+				m_ops->destroy(m_storage);
+				m_ops = nullptr;
+			}
+		}
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		alignas(std::max_align_t) mutable unsigned char m_storage[Capacity]; ///< The stored callable
+		const Ops*                                      m_ops;               ///< The stored callable's operations, or nullptr if empty
+	};
+
 	template<typename... Args>
-	using Function = std::function<void(Args...)>;
+	using Function = InplaceFunction<void(Args...)>;
 
 } //namespace spss
@@ -0,0 +1,240 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::GapBuffer is a sequence container optimised for editing
+/// around a moving position, such as a text caret.
+///
+/// Elements are stored in a single array containing a "gap" of
+/// unused slots. Insertions and erasures happen at the gap, which
+/// only has to be moved when the edit position changes, so
+/// consecutive edits around the same position are O(1) amortized
+/// and don't allocate.
+////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace spss {
+
+	template<typename T>
+	class GapBuffer {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty gap buffer
+		///
+		/// \param _capacity The initial capacity
+		///
+		////////////////////////////////////////////////////////////
+		explicit GapBuffer(size_t _capacity = 16)
+		            : m_data(_capacity), m_gapBegin{0}, m_gapEnd{_capacity} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of elements
+		///
+		////////////////////////////////////////////////////////////
+		size_t size() const {
+			return m_data.size() - gapSize();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is the buffer empty?
+		///
+		////////////////////////////////////////////////////////////
+		bool empty() const {
+			return size() == 0;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Access the element at the given position
+		///
+		/// \param _pos The position
+		///
+		////////////////////////////////////////////////////////////
+		const T& operator[](size_t _pos) const {
+			return m_data[physicalIndex(_pos)];
+		}
+
+		T& operator[](size_t _pos) {
+			return m_data[physicalIndex(_pos)];
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Insert an element before the given position
+		///
+		/// \param _pos   The position
+		/// \param _value The element
+		///
+		////////////////////////////////////////////////////////////
+		void insert(size_t _pos, const T& _value) {
+			reserveGap(1);
+			moveGap(_pos);
+			m_data[m_gapBegin++] = _value;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Insert a range of elements before the given position
+		///
+		/// \param _pos   The position
+		/// \param _first The beginning of the range
+		/// \param _last  The end of the range
+		///
+		////////////////////////////////////////////////////////////
+		template<typename InputIt>
+		void insert(size_t _pos, InputIt _first, InputIt _last) {
+			size_t count{size_t(std::distance(_first, _last))};
+			reserveGap(count);
+			moveGap(_pos);
+			std::copy(_first, _last, m_data.begin() + m_gapBegin);
+			m_gapBegin += count;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Erase elements starting at the given position
+		///
+		/// \param _pos   The position of the first element to erase
+		/// \param _count The amount of elements to erase
+		///
+		////////////////////////////////////////////////////////////
+		void erase(size_t _pos, size_t _count = 1) {
+			if (_pos >= size()) {
+				return;
+			}
+			_count = std::min(_count, size() - _pos);
+			moveGap(_pos);
+			m_gapEnd += _count;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Erase all elements
+		///
+		/// The capacity is kept.
+		///
+		////////////////////////////////////////////////////////////
+		void clear() {
+			m_gapBegin = 0;
+			m_gapEnd   = m_data.size();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Replace the contents with a range of elements
+		///
+		/// \param _first The beginning of the range
+		/// \param _last  The end of the range
+		///
+		////////////////////////////////////////////////////////////
+		template<typename InputIt>
+		void assign(InputIt _first, InputIt _last) {
+			clear();
+			insert(0, _first, _last);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Copy a range of elements to an output iterator
+		///
+		/// \param _pos   The position of the first element to copy
+		/// \param _count The amount of elements to copy
+		/// \param _out   The output iterator
+		///
+		////////////////////////////////////////////////////////////
+		template<typename OutputIt>
+		OutputIt copy(size_t _pos, size_t _count, OutputIt _out) const {
+			if (_pos >= size()) {
+				return _out;
+			}
+
+			size_t end{_pos + std::min(_count, size() - _pos)};
+
+			//The elements before the gap...
+			if (_pos < m_gapBegin) {
+				_out = std::copy(m_data.begin() + _pos,
+				                 m_data.begin() + std::min(end, m_gapBegin),
+				                 _out);
+			}
+
+			//...and the ones after it
+			if (end > m_gapBegin) {
+				_out = std::copy(m_data.begin() + physicalIndex(std::max(_pos, m_gapBegin)),
+				                 m_data.begin() + physicalIndex(end - 1) + 1,
+				                 _out);
+			}
+
+			return _out;
+		}
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief Get the size of the gap
+		///
+		////////////////////////////////////////////////////////////
+		size_t gapSize() const {
+			return m_gapEnd - m_gapBegin;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Translate a logical position into an index of m_data
+		///
+		////////////////////////////////////////////////////////////
+		size_t physicalIndex(size_t _pos) const {
+			return _pos < m_gapBegin ? _pos : _pos + gapSize();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move the gap so that it begins at the given position
+		///
+		/// Only the elements between the old and new position of the
+		/// gap are moved.
+		///
+		////////////////////////////////////////////////////////////
+		void moveGap(size_t _pos) {
+			if (_pos < m_gapBegin) {
+				size_t count{m_gapBegin - _pos};
+				std::move_backward(m_data.begin() + _pos,
+				                   m_data.begin() + m_gapBegin,
+				                   m_data.begin() + m_gapEnd);
+				m_gapBegin -= count;
+				m_gapEnd -= count;
+			}
+			else if (_pos > m_gapBegin) {
+				size_t count{_pos - m_gapBegin};
+				std::move(m_data.begin() + m_gapEnd,
+				          m_data.begin() + m_gapEnd + count,
+				          m_data.begin() + m_gapBegin);
+				m_gapBegin += count;
+				m_gapEnd += count;
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Ensure the gap can hold at least _count elements
+		///
+		/// The capacity is at least doubled when growing, so that
+		/// insertions are O(1) amortized.
+		///
+		////////////////////////////////////////////////////////////
+		void reserveGap(size_t _count) {
+			if (gapSize() >= _count) {
+				return;
+			}
+
+			size_t         afterGap{m_data.size() - m_gapEnd};
+			size_t         newCapacity{std::max(2 * m_data.size(), size() + _count + 16)};
+			std::vector<T> data(newCapacity);
+
+			std::move(m_data.begin(), m_data.begin() + m_gapBegin, data.begin());
+			std::move(m_data.begin() + m_gapEnd, m_data.end(), data.end() - afterGap);
+
+			m_gapEnd = newCapacity - afterGap;
+			m_data.swap(data);
+		}
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		std::vector<T> m_data;     ///< The elements, including the gap
+		size_t         m_gapBegin; ///< The index of the first slot of the gap
+		size_t         m_gapEnd;   ///< The index one past the last slot of the gap
+	};
+
+} //namespace spss
@@ -0,0 +1,168 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::PrefixIndex is a CompletionProvider that answers prefix
+/// queries over a large, fixed set of words (such as identifiers).
+///
+/// The words are kept in a single sorted array, so all words
+/// sharing a prefix are contiguous: a query binary searches for the
+/// first of them and then reads the next k, which is
+/// O(prefix * log n + k) with no allocations besides the results.
+///
+/// Sorting hundreds of thousands of words takes a noticeable amount
+/// of time, so the index can be built on a worker thread with
+/// buildAsync(). Until the worker is done, queries keep on using
+/// the words the index had before (none, for a new index).
+///
+/// Starting a build while another one is running doesn't wait for
+/// the older one: it's set aside, its words are dropped once it's
+/// done, and only the newest build's words are used. Destroying the
+/// index does wait for the builds still running.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/CompletionProvider.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace spss {
+
+	class PrefixIndex : public spss::CompletionProvider {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty index
+		///
+		////////////////////////////////////////////////////////////
+		PrefixIndex()
+		            : m_words{}, m_pending{}, m_superseded{} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Build the index on the calling thread
+		///
+		/// \param _words The words to index, in any order
+		///
+		////////////////////////////////////////////////////////////
+		void build(std::vector<std::string> _words) {
+			supersedePending();
+			m_words = sortWords(std::move(_words));
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Build the index on a worker thread
+		///
+		/// The current words stay queryable until the new ones are
+		/// ready.
+		///
+		/// \param _words The words to index, in any order
+		///
+		////////////////////////////////////////////////////////////
+		void buildAsync(std::vector<std::string> _words) {
+			supersedePending();
+			m_pending = std::async(std::launch::async, &PrefixIndex::sortWords, std::move(_words));
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is a build still running on a worker thread?
+		///
+		////////////////////////////////////////////////////////////
+		bool building() const {
+			collect();
+			return m_pending.valid();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the amount of indexed words
+		///
+		////////////////////////////////////////////////////////////
+		size_t size() const {
+			collect();
+			return m_words.size();
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Find the words starting with a prefix
+		///
+		/// The words are found in lexicographical order.
+		///
+		/// \param _prefix The prefix, encoded in UTF-8
+		/// \param _max    The maximum amount of words to find
+		/// \param _out    The vector the words are appended to
+		///
+		////////////////////////////////////////////////////////////
+		void complete(const std::string&        _prefix,
+		              size_t                    _max,
+		              std::vector<std::string>& _out) const override {
+			collect();
+
+			auto it{std::lower_bound(m_words.begin(), m_words.end(), _prefix)};
+
+			for (; it != m_words.end() && _max > 0; ++it, --_max) {
+				if (it->compare(0, _prefix.size(), _prefix) != 0) {
+					break;
+				}
+				_out.push_back(*it);
+			}
+		}
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief Sort the words and remove duplicates
+		///
+		////////////////////////////////////////////////////////////
+		static std::vector<std::string> sortWords(std::vector<std::string> _words) {
+			std::sort(_words.begin(), _words.end());
+			_words.erase(std::unique(_words.begin(), _words.end()), _words.end());
+			_words.shrink_to_fit();
+			return _words;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is a worker thread's build done?
+		///
+		////////////////////////////////////////////////////////////
+		static bool isReady(const std::future<std::vector<std::string>>& _build) {
+			return _build.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Set the running build aside, if there's one
+		///
+		/// A future from std::async blocks in its destructor until
+		/// the build is done, so rather than being replaced, it's
+		/// kept until collect() finds it done.
+		///
+		////////////////////////////////////////////////////////////
+		void supersedePending() {
+			if (m_pending.valid()) {
+				m_superseded.push_back(std::move(m_pending));
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Take the words from the worker thread if it's done
+		///
+		/// Also drops the superseded builds that are done. Never
+		/// blocks.
+		///
+		////////////////////////////////////////////////////////////
+		void collect() const {
+			m_superseded.erase(std::remove_if(m_superseded.begin(), m_superseded.end(), isReady), m_superseded.end());
+
+			if (m_pending.valid() && isReady(m_pending)) {
+				m_words = m_pending.get();
+			}
+		}
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		mutable std::vector<std::string>                           m_words;      ///< The sorted, unique words
+		mutable std::future<std::vector<std::string>>              m_pending;    ///< The words being sorted on a worker thread
+		mutable std::vector<std::future<std::vector<std::string>>> m_superseded; ///< Older builds still running, whose words are dropped
+	};
+
+} //namespace spss
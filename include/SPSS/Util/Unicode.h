@@ -0,0 +1,18 @@
+#pragma once
+
+namespace spss::Util::Unicode {
+
+	////////////////////////////////////////////////////////////
+	/// \brief Is the code point a control character?
+	///
+	/// 0-31 and 127-159 are control characters, which includes
+	/// line breaks and tabs.
+	///
+	/// \param _unicode The code point
+	///
+	////////////////////////////////////////////////////////////
+	inline bool isControl(unsigned int _unicode) {
+		return _unicode < 32 || (_unicode >= 127 && _unicode < 160);
+	}
+
+} // namespace spss::Util::Unicode
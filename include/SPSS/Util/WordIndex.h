@@ -0,0 +1,240 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////
+/// spss::WordIndex keeps track of the word boundaries of a piece of
+/// text, so that "skipping" words (CTRL + arrow keys) doesn't have
+/// to scan the text.
+///
+/// The text is represented as alternating runs of separator (space)
+/// and non-separator characters, stored in a GapBuffer. A cursor
+/// remembers which run the last query or edit touched, along with
+/// the position at which that run begins. Since edits and queries
+/// tend to happen around the caret, moving the cursor is O(1)
+/// amortized, and so are single character edits and word queries.
+////////////////////////////////////////////////////////////////////
+
+#include <SPSS/Util/GapBuffer.h>
+
+namespace spss {
+
+	class WordIndex {
+	  public:
+		////////////////////////////////////////////////////////////
+		/// \brief Construct an empty word index
+		///
+		////////////////////////////////////////////////////////////
+		WordIndex()
+		            : m_runs{}, m_size{0}, m_cursor{0}, m_cursorStart{0} {
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Get the length of the indexed text
+		///
+		////////////////////////////////////////////////////////////
+		size_t size() const {
+			return m_size;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Clear the index
+		///
+		////////////////////////////////////////////////////////////
+		void clear() {
+			m_runs.clear();
+			m_size        = 0;
+			m_cursor      = 0;
+			m_cursorStart = 0;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Index characters inserted into the text
+		///
+		/// \param _pos   The position the characters were inserted at
+		/// \param _first The beginning of the inserted characters
+		/// \param _last  The end of the inserted characters
+		///
+		////////////////////////////////////////////////////////////
+		template<typename InputIt>
+		void insert(size_t _pos, InputIt _first, InputIt _last) {
+			for (; _first != _last; ++_first) {
+				insert(_pos++, isSeparator(*_first));
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Index a character inserted into the text
+		///
+		/// \param _pos       The position the character was inserted at
+		/// \param _separator Is the character a word separator?
+		///
+		////////////////////////////////////////////////////////////
+		void insert(size_t _pos, bool _separator) {
+			seek(_pos);
+			++m_size;
+
+			//Inserting into the middle of a run either lengthens
+			//it or splits it in two
+			if (m_cursor < m_runs.size() && _pos > m_cursorStart) {
+				Run& run{m_runs[m_cursor]};
+				if (run.separator == _separator) {
+					++run.length;
+					return;
+				}
+
+				Run tail{run.length - (_pos - m_cursorStart), run.separator};
+				run.length = _pos - m_cursorStart;
+				m_runs.insert(m_cursor + 1, Run{1, _separator});
+				m_runs.insert(m_cursor + 2, tail);
+				return;
+			}
+
+			//Otherwise we're between two runs, which are of different
+			//types, so one of them can always be lengthened unless
+			//we're at the very beginning or end of the text
+			if (m_cursor > 0 && m_runs[m_cursor - 1].separator == _separator) {
+				++m_runs[m_cursor - 1].length;
+				++m_cursorStart;
+			}
+			else if (m_cursor < m_runs.size() && m_runs[m_cursor].separator == _separator) {
+				++m_runs[m_cursor].length;
+			}
+			else {
+				m_runs.insert(m_cursor, Run{1, _separator});
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Remove characters erased from the text
+		///
+		/// \param _pos   The position of the first erased character
+		/// \param _count The amount of erased characters
+		///
+		////////////////////////////////////////////////////////////
+		void erase(size_t _pos, size_t _count = 1) {
+			for (size_t i{0}; i < _count && _pos < m_size; i++) {
+				eraseOne(_pos);
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Returns the position of the start of the last word
+		///
+		/// Any separators directly before _from are skipped first.
+		///
+		/// \param _from The position from which to start
+		///
+		////////////////////////////////////////////////////////////
+		size_t previousWord(size_t _from) const {
+			if (_from == 0) {
+				return 0;
+			}
+
+			seek(_from - 1);
+
+			if (!m_runs[m_cursor].separator) {
+				return m_cursorStart;
+			}
+			if (m_cursor == 0) {
+				return 0;
+			}
+			return m_cursorStart - m_runs[m_cursor - 1].length;
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Returns the position of the end of the next word
+		///
+		/// Any separators directly after _from are skipped first.
+		///
+		/// \param _from The position from which to start
+		///
+		////////////////////////////////////////////////////////////
+		size_t nextWord(size_t _from) const {
+			if (_from >= m_size) {
+				return m_size;
+			}
+
+			seek(_from);
+
+			size_t pos{m_cursorStart + m_runs[m_cursor].length};
+
+			if (m_runs[m_cursor].separator && m_cursor + 1 < m_runs.size()) {
+				pos += m_runs[m_cursor + 1].length;
+			}
+
+			return pos;
+		}
+
+	  private:
+		////////////////////////////////////////////////////////////
+		/// \brief A run of characters of the same type
+		///
+		////////////////////////////////////////////////////////////
+		struct Run {
+			size_t length;
+			bool   separator;
+		};
+
+		////////////////////////////////////////////////////////////
+		/// \brief Is the character a word separator?
+		///
+		////////////////////////////////////////////////////////////
+		template<typename CharType>
+		static bool isSeparator(CharType _c) {
+			return _c == CharType(' ');
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Move the cursor to the run containing _pos
+		///
+		/// If _pos is the end of the text, the cursor is moved past
+		/// the last run.
+		///
+		////////////////////////////////////////////////////////////
+		void seek(size_t _pos) const {
+			while (m_cursor > 0 && _pos < m_cursorStart) {
+				--m_cursor;
+				m_cursorStart -= m_runs[m_cursor].length;
+			}
+			while (m_cursor < m_runs.size() &&
+			       _pos >= m_cursorStart + m_runs[m_cursor].length) {
+				m_cursorStart += m_runs[m_cursor].length;
+				++m_cursor;
+			}
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Remove a single erased character
+		///
+		/// If the run becomes empty it's removed, and its neighbours,
+		/// which are of the same type, are merged.
+		///
+		////////////////////////////////////////////////////////////
+		void eraseOne(size_t _pos) {
+			seek(_pos);
+			--m_size;
+
+			if (--m_runs[m_cursor].length > 0) {
+				return;
+			}
+
+			m_runs.erase(m_cursor);
+
+			if (m_cursor > 0 && m_cursor < m_runs.size()) {
+				size_t leftLength{m_runs[m_cursor - 1].length};
+				m_runs[m_cursor - 1].length += m_runs[m_cursor].length;
+				m_runs.erase(m_cursor);
+				--m_cursor;
+				m_cursorStart -= leftLength;
+			}
+		}
+
+		///////////////////////////////////////////////////////////
+		//Data members --------------------------------------------
+		///////////////////////////////////////////////////////////
+		GapBuffer<Run> m_runs;        ///< The alternating separator/non-separator runs
+		size_t         m_size;        ///< The length of the indexed text
+		mutable size_t m_cursor;      ///< The index of the run last seeked to
+		mutable size_t m_cursorStart; ///< The position at which the run at m_cursor begins
+	};
+
+} //namespace spss
@@ -0,0 +1,306 @@
+#include <SPSS/Graphics/DialogManager.h>
+
+#include <SPSS/System/InputSnapshot.h>
+
+#include <algorithm>
+#include <iterator>
+
+constexpr float TOAST_MARGIN{10.F};
+constexpr float TOAST_SPACING{5.F};
+
+constexpr size_t DEFAULT_MAX_TOASTS{3};
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	DialogManager::DialogManager(sf::RenderWindow& _window,
+	                             const sf::Font&   _font,
+	                             unsigned int      _charSize)
+	            : m_window{_window},
+	              m_font{_font},
+	              m_charSize{_charSize},
+	              m_dialogs{},
+	              m_toasts{},
+	              m_queuedToasts{},
+	              m_maxToasts{DEFAULT_MAX_TOASTS},
+	              m_stackNeeded{false},
+	              m_closing{},
+	              m_pool{},
+	              m_textEntryPool{},
+	              m_hovered{nullptr},
+	              m_captured{nullptr} {
+	}
+
+	////////////////////////////////////////////////////////////
+	DialogPrompt& DialogManager::openDialog(const std::string&  _title,
+	                                        const sf::Vector2f& _position,
+	                                        bool                _textEntryEnabled) {
+		auto prompt{acquire(_title, _textEntryEnabled)};
+		prompt->setPosition(_position);
+		prompt->alignElements();
+
+		m_dialogs.push_back(std::move(prompt));
+		return *m_dialogs.back();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::close(const DialogPrompt& _prompt) {
+		m_closing.push_back(&_prompt);
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::closeAll() {
+		for (auto& dialog : m_dialogs) {
+			close(*dialog);
+		}
+		for (auto& toast : m_toasts) {
+			close(*toast.prompt);
+		}
+		m_queuedToasts.clear();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::showToast(const std::string& _message, float _duration) {
+		m_queuedToasts.push_back({_message, _duration});
+		showQueuedToasts();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::setMaxToasts(size_t _count) {
+		m_maxToasts = _count;
+		showQueuedToasts();
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t DialogManager::getDialogCount() const {
+		return m_dialogs.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t DialogManager::getToastCount() const {
+		return m_toasts.size() + m_queuedToasts.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::getInput(sf::Event& _e) {
+		switch (_e.type) {
+		case sf::Event::MouseMoved: {
+			//The prompt that was hovered gets the move as well, so
+			//that it can clear its highlights
+			DialogPrompt* target{m_captured != nullptr ? m_captured : findPromptUnderCursor()};
+			if (m_hovered != nullptr && m_hovered != target) {
+				m_hovered->getInput(_e);
+			}
+			m_hovered = target;
+
+			if (target != nullptr) {
+				target->getInput(_e);
+			}
+			break;
+		}
+
+		case sf::Event::MouseButtonPressed: {
+			DialogPrompt* target{findPromptUnderCursor()};
+			if (target == nullptr) {
+				break;
+			}
+
+			//Clicking a toast dismisses it
+			if (isToast(target)) {
+				close(*target);
+				break;
+			}
+
+			raise(target);
+			m_captured = target;
+			target->getInput(_e);
+			break;
+		}
+
+		//The release goes to whichever prompt got the press, even
+		//if the cursor has left it since
+		case sf::Event::MouseButtonReleased:
+			if (m_captured != nullptr) {
+				m_captured->getInput(_e);
+				m_captured = nullptr;
+			}
+			break;
+
+		case sf::Event::MouseWheelScrolled:
+		case sf::Event::MouseEntered:
+		case sf::Event::MouseLeft:
+			break;
+
+		case sf::Event::Resized:
+			m_stackNeeded = true;
+			break;
+
+		//Keyboard input only goes to the dialog in front
+		default:
+			if (!m_dialogs.empty()) {
+				m_dialogs.back()->getInput(_e);
+			}
+			break;
+		}
+
+		releaseClosed();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::update() {
+		for (auto& toast : m_toasts) {
+			if (toast.lifetime.finished()) {
+				close(*toast.prompt);
+			}
+		}
+		releaseClosed();
+
+		if (m_stackNeeded) {
+			stackToasts();
+		}
+
+		for (auto& dialog : m_dialogs) {
+			dialog->update();
+		}
+		for (auto& toast : m_toasts) {
+			toast.prompt->update();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::draw(sf::RenderWindow& window, sf::RenderStates states) const {
+		for (auto& dialog : m_dialogs) {
+			window.draw(*dialog, states);
+		}
+		for (auto& toast : m_toasts) {
+			window.draw(*toast.prompt, states);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::unique_ptr<DialogPrompt> DialogManager::acquire(const std::string& _title, bool _textEntryEnabled) {
+		auto& pool{_textEntryEnabled ? m_textEntryPool : m_pool};
+
+		if (pool.empty()) {
+			return std::make_unique<DialogPrompt>(_textEntryEnabled, sf::Vector2f{}, m_font, _title, m_charSize, "", m_charSize);
+		}
+
+		auto prompt{std::move(pool.back())};
+		pool.pop_back();
+		prompt->reset(_title);
+		return prompt;
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::releaseClosed() {
+		if (m_closing.empty()) {
+			return;
+		}
+
+		bool toastClosed{false};
+		for (const DialogPrompt* prompt : m_closing) {
+			if (m_hovered == prompt) {
+				m_hovered = nullptr;
+			}
+			if (m_captured == prompt) {
+				m_captured = nullptr;
+			}
+
+			std::unique_ptr<DialogPrompt> released;
+
+			auto dialog{std::find_if(m_dialogs.begin(), m_dialogs.end(), [prompt](const auto& _d) { return _d.get() == prompt; })};
+			if (dialog != m_dialogs.end()) {
+				released = std::move(*dialog);
+				m_dialogs.erase(dialog);
+			}
+
+			auto toast{std::find_if(m_toasts.begin(), m_toasts.end(), [prompt](const Toast& _t) { return _t.prompt.get() == prompt; })};
+			if (toast != m_toasts.end()) {
+				released = std::move(toast->prompt);
+				m_toasts.erase(toast);
+				toastClosed = true;
+			}
+
+			//A prompt closed twice is only released once
+			if (released != nullptr) {
+				(released->hasTextEntry() ? m_textEntryPool : m_pool).push_back(std::move(released));
+			}
+		}
+		m_closing.clear();
+
+		//The toasts are moved up right away, rather than on the
+		//next update, so none are drawn where they were
+		if (toastClosed) {
+			stackToasts();
+		}
+		showQueuedToasts();
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::showQueuedToasts() {
+		bool shown{false};
+		while (m_toasts.size() < m_maxToasts && !m_queuedToasts.empty()) {
+			const QueuedToast& queued{m_queuedToasts.front()};
+
+			Toast toast{acquire(queued.message, false),
+			            Animator::get_instance().tween(0.F, 1.F, queued.duration)};
+			toast.prompt->setDraggable(false);
+
+			m_toasts.push_back(std::move(toast));
+			m_queuedToasts.pop_front();
+			shown = true;
+		}
+
+		if (shown) {
+			stackToasts();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::stackToasts() {
+		m_stackNeeded = false;
+
+		const sf::View& view{m_window.getView()};
+		float           right{view.getCenter().x + view.getSize().x / 2 - TOAST_MARGIN};
+		float           top{view.getCenter().y - view.getSize().y / 2 + TOAST_MARGIN};
+
+		//The prompts' origins are centered
+		for (auto& toast : m_toasts) {
+			const sf::Vector2f& size{toast.prompt->getSize()};
+			toast.prompt->setPosition({right - size.x / 2, top + size.y / 2});
+			toast.prompt->alignElements();
+			top += size.y + TOAST_SPACING;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	DialogPrompt* DialogManager::findPromptUnderCursor() const {
+		auto mousePos{InputSnapshot::get_instance().getMousePosition(m_window, m_window.getView())};
+
+		for (auto it{m_toasts.rbegin()}; it != m_toasts.rend(); ++it) {
+			if (it->prompt->getGlobalBounds().contains(mousePos)) {
+				return it->prompt.get();
+			}
+		}
+		for (auto it{m_dialogs.rbegin()}; it != m_dialogs.rend(); ++it) {
+			if ((*it)->getGlobalBounds().contains(mousePos)) {
+				return it->get();
+			}
+		}
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool DialogManager::isToast(const DialogPrompt* _prompt) const {
+		return std::any_of(m_toasts.begin(), m_toasts.end(), [_prompt](const Toast& _t) { return _t.prompt.get() == _prompt; });
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogManager::raise(const DialogPrompt* _prompt) {
+		auto it{std::find_if(m_dialogs.begin(), m_dialogs.end(), [_prompt](const auto& _d) { return _d.get() == _prompt; })};
+		if (it != m_dialogs.end()) {
+			std::rotate(it, std::next(it), m_dialogs.end());
+		}
+	}
+
+} //namespace spss
@@ -1,5 +1,6 @@
 #include <SPSS/Graphics/DialogPrompt.h>
 
+#include <SPSS/System/InputSnapshot.h>
 #include <SPSS/Util/Input.h>
 
 constexpr float MAX_WIDTH{650.F};
@@ -14,6 +15,9 @@ constexpr float TITLE_TOP_PADDING{5.F};
 constexpr float TEXT_SIDE_PADDING{20.F};
 constexpr float TEXTENTRY_TOP_PADDING{5.F};
 
+constexpr float HOVER_FADE_TIME{120.F};
+
+const sf::Color DEFAULT_COLOR{0, 0, 0, 100};
 const sf::Color HIGHLIGHTED_BORDER{sf::Color::White};
 const sf::Color UNHIGHLIGHTED_BORDER{255, 255, 255, 75};
 
@@ -30,33 +34,22 @@ namespace spss {
 	            : m_window{nullptr},
 	              m_font{_font},
 	              m_lastMousePosition{},
-	              m_lastPosition{_position},
 	              m_draggable{true},
 	              m_dragging{false},
 	              m_rect{{MAX_WIDTH, 100}},
 	              m_textEntry{!_textEntryEnabled ? nullptr : std::make_unique<TextEntryBox>(MAX_WIDTH, _position, m_font, _boxCharSize, _boxDefaultStr)},
-	              m_alignmentNeeded{true} {
+	              m_measureNeeded{true},
+	              m_arrangeNeeded{true},
+	              m_textEntryTop{0.F},
+	              m_buttonsTop{0.F} {
 		m_title.setCharacterSize(_titleCharSize);
 		m_title.setFont(m_font);
 		m_title.setString(_promptTitle);
 
-		m_rect.setFillColor({0, 0, 0, 100});
+		m_rect.setFillColor(DEFAULT_COLOR);
 		m_rect.setOutlineThickness(1);
 
-		float titleWidth{m_title.getGlobalBounds().width};
-
-		if (titleWidth <= MIN_WIDTH) {
-			setWidth(MIN_WIDTH);
-		}
-
-		else if (titleWidth <= MAX_WIDTH) {
-			setWidth(titleWidth);
-		}
-
-		else {
-			setWidth(MAX_WIDTH);
-		}
-
+		fitTitle();
 		setPosition(_position);
 
 		if (m_textEntry != nullptr) {
@@ -69,6 +62,25 @@ namespace spss {
 		alignElements();
 	}
 
+	////////////////////////////////////////////////////////////
+	void DialogPrompt::reset(const std::string& _promptTitle) {
+		m_title.setString(_promptTitle);
+		fitTitle();
+
+		//clear() keeps the buttons' capacity, so a reused prompt
+		//doesn't allocate again for the same amount of buttons
+		m_buttons.clear();
+		if (m_textEntry != nullptr) {
+			m_textEntry->clear();
+		}
+
+		m_rect.setFillColor(DEFAULT_COLOR);
+		m_draggable = true;
+		m_dragging  = false;
+
+		alignElements();
+	}
+
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::getInput(sf::Event& _e) {
 		if (m_textEntry != nullptr) {
@@ -97,12 +109,21 @@ namespace spss {
 			m_textEntry->update();
 		}
 
-		if (m_rect.getPosition() != m_lastPosition) {
-			m_lastPosition    = m_rect.getPosition();
-			m_alignmentNeeded = true;
-		}
-
 		alignElements();
+
+		//Busy buttons are faded until their action returns
+		for (auto& b : m_buttons) {
+			sf::Color textColor{b.m_text.getFillColor()};
+			textColor.a = b.m_task.isPending() ? 100 : 255;
+			b.m_text.setFillColor(textColor);
+
+			if (b.m_hover.isActive()) {
+				b.m_shape.setOutlineColor(b.m_hover.getColor());
+				if (b.m_hover.finished()) {
+					b.m_hover = Animator::Tween{};
+				}
+			}
+		}
 	}
 
 	////////////////////////////////////////////////////////////
@@ -120,7 +141,7 @@ namespace spss {
 	}
 
 	////////////////////////////////////////////////////////////
-	void DialogPrompt::addButton(const std::string& _str, spss::Function<std::any> _action) {
+	void DialogPrompt::addButton(const std::string& _str, spss::Function<> _action) {
 		Button b;
 
 		b.m_action = _action;
@@ -143,8 +164,22 @@ namespace spss {
 		                     b.m_text.getGlobalBounds().width / 2,
 		                   0);
 
-		m_buttons.push_back(b);
-		m_alignmentNeeded = true;
+		m_buttons.push_back(std::move(b));
+		m_measureNeeded = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void DialogPrompt::addAsyncButton(const std::string& _str,
+	                                  spss::Function<>   _action,
+	                                  spss::Function<>   _onComplete) {
+		addButton(_str, _action);
+		m_buttons.back().m_async      = true;
+		m_buttons.back().m_onComplete = _onComplete;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool DialogPrompt::hasTextEntry() const {
+		return m_textEntry != nullptr;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -168,12 +203,12 @@ namespace spss {
 	}
 
 	////////////////////////////////////////////////////////////
-	const sf::FloatRect& DialogPrompt::getLocalBounds() const {
+	sf::FloatRect DialogPrompt::getLocalBounds() const {
 		return m_rect.getLocalBounds();
 	}
 
 	////////////////////////////////////////////////////////////
-	const sf::FloatRect& DialogPrompt::getGlobalBounds() const {
+	sf::FloatRect DialogPrompt::getGlobalBounds() const {
 		return m_rect.getGlobalBounds();
 	}
 
@@ -185,7 +220,7 @@ namespace spss {
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::setPosition(const sf::Vector2f& _pos) {
 		m_rect.setPosition(_pos);
-		m_alignmentNeeded = true;
+		m_arrangeNeeded = true;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -247,6 +282,23 @@ namespace spss {
 		m_title.setString(str);
 	}
 
+	////////////////////////////////////////////////////////////
+	void DialogPrompt::fitTitle() {
+		float titleWidth{m_title.getGlobalBounds().width};
+
+		if (titleWidth <= MIN_WIDTH) {
+			setWidth(MIN_WIDTH);
+		}
+
+		else if (titleWidth <= MAX_WIDTH) {
+			setWidth(titleWidth);
+		}
+
+		else {
+			setWidth(MAX_WIDTH);
+		}
+	}
+
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::setHeight(float _height) {
 		m_rect.setSize({m_rect.getSize().x, _height});
@@ -255,7 +307,7 @@ namespace spss {
 		m_rect.setOrigin(bounds.left + (bounds.width / 2),
 		                 bounds.top + (bounds.height / 2));
 
-		m_alignmentNeeded = true;
+		m_arrangeNeeded = true;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -271,14 +323,14 @@ namespace spss {
 		m_rect.setOrigin(bounds.left + (bounds.width / 2),
 		                 bounds.top + (bounds.height / 2));
 
-		m_alignmentNeeded = true;
+		m_measureNeeded = true;
 	}
 
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::handleMouseClick() {
-		auto view{m_window->getView()};
-		auto mousePos = sf::Mouse::getPosition(*m_window);
-		auto pixelPos{m_window->mapPixelToCoords(mousePos, view)};
+		auto& input{InputSnapshot::get_instance()};
+		auto  mousePos{input.getMousePixel()};
+		auto  pixelPos{input.getMousePosition(*m_window, m_window->getView())};
 
 		auto bounds{m_rect.getGlobalBounds()};
 		bool insideBox{bounds.contains(pixelPos.x, pixelPos.y)};
@@ -289,11 +341,23 @@ namespace spss {
 			bool buttonNull{b.m_action == nullptr};
 
 			if (insideButton && !buttonNull) {
-				b.m_action(std::any());
+				if (!b.m_async) {
+					b.m_action();
+				}
+				else if (!b.m_task.isPending()) {
+					b.m_task = TaskPool::get_instance().dispatch(b.m_action, b.m_onComplete);
+				}
 				return;
 			}
 		}
 
+		//Clicking the text entry box selects text rather than
+		//dragging the prompt around
+		if (m_textEntry != nullptr &&
+		    m_textEntry->getGlobalBounds().contains(pixelPos.x, pixelPos.y)) {
+			return;
+		}
+
 		if (insideBox) {
 			m_lastMousePosition = mousePos;
 			m_dragging          = true;
@@ -302,20 +366,24 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::handleMouseover() {
-		auto view{m_window->getView()};
-		auto mousePos = sf::Mouse::getPosition(*m_window);
-		auto pixelPos{m_window->mapPixelToCoords(mousePos, view)};
+		auto& input{InputSnapshot::get_instance()};
+		auto  mousePos{input.getMousePixel()};
+		auto  pixelPos{input.getMousePosition(*m_window, m_window->getView())};
 
 		for (auto& b : m_buttons) {
 			auto buttonBounds{b.m_shape.getGlobalBounds()};
 			bool insideButton{buttonBounds.contains(pixelPos.x, pixelPos.y)};
-			bool buttonNull{b.m_action == nullptr};
-
-			if (insideButton && !buttonNull) {
-				b.m_shape.setOutlineColor(HIGHLIGHTED_BORDER);
-			}
-			else {
-				b.m_shape.setOutlineColor(UNHIGHLIGHTED_BORDER);
+			bool buttonNull{b.m_action == nullptr || b.m_task.isPending()};
+			bool hovered{insideButton && !buttonNull};
+
+			//The border fades from wherever it is, so moving in and
+			//out quickly doesn't make it jump
+			if (hovered != b.m_hovered) {
+				b.m_hovered = hovered;
+				b.m_hover   = Animator::get_instance().tween(b.m_shape.getOutlineColor(),
+				                                             hovered ? HIGHLIGHTED_BORDER : UNHIGHLIGHTED_BORDER,
+				                                             HOVER_FADE_TIME,
+				                                             Animator::Easing::QuadOut);
 			}
 		}
 	}
@@ -325,7 +393,7 @@ namespace spss {
 		if (!m_draggable || !m_dragging || m_window == nullptr) {
 			return;
 		}
-		sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
+		sf::Vector2i mousePos{InputSnapshot::get_instance().getMousePixel()};
 
 		sf::Vector2i diff{mousePos.x - m_lastMousePosition.x,
 		                  mousePos.y - m_lastMousePosition.y};
@@ -371,52 +439,31 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void DialogPrompt::alignElements() {
-		if (!m_alignmentNeeded) {
-			return;
+		if (m_measureNeeded) {
+			measure();
 		}
-
-		m_alignmentNeeded = false;
-
-		auto rectBounds{m_rect.getGlobalBounds()};
-
-		//For the purpose of aligning elements, we'll want to get the position of
-		//the upperleft most corner of m_rect. This is why we don't call m_rect.getPosition()
-		//(which would return the center of the box, since the origin is always centered)
-
-		sf::Vector2f pos{rectBounds.left, rectBounds.top};
-		auto         size{m_rect.getSize()};
-
-		m_title.setPosition({pos.x + TEXT_SIDE_PADDING, pos.y + TITLE_TOP_PADDING});
-
-		auto titleBounds{m_title.getGlobalBounds()};
-
-		if (m_textEntry != nullptr) {
-			m_textEntry->setPosition({pos.x + TEXT_SIDE_PADDING,
-			                          titleBounds.top + titleBounds.height + TEXTENTRY_TOP_PADDING});
+		if (m_arrangeNeeded) {
+			arrange();
 		}
+	}
 
-		//We'll get the FloatRect describing the space where the buttons
-		//can be placed - that is, everything below the text entry box
-
-		//If we have a text entry box, our buttons will appear directly
-		//below the title, so we'll use the title's bounds instead.
-
-		//If we have a text entry box though, the buttons will appear
-		//below it.
+	////////////////////////////////////////////////////////////
+	void DialogPrompt::measure() {
+		m_measureNeeded = false;
 
-		auto bottomElementBounds{m_textEntry == nullptr ? m_title.getGlobalBounds() : m_textEntry->getGlobalBounds()};
+		//The title is placed at the very top, and the text entry
+		//box, if any, directly below it
+		auto  titleBounds{m_title.getLocalBounds()};
+		float bottom{TITLE_TOP_PADDING + titleBounds.top + titleBounds.height};
 
-		float rectBottom{rectBounds.top + rectBounds.height};
-		float bottomElementBottom{bottomElementBounds.top + bottomElementBounds.height};
+		if (m_textEntry != nullptr) {
+			auto textEntryBounds{m_textEntry->getLocalBounds()};
 
-		sf::FloatRect buttonBounds{rectBounds.left,
-		                           bottomElementBottom + BUTTON_TOP_PADDING,
-		                           size.x,
-		                           rectBottom - bottomElementBottom};
+			m_textEntryTop = bottom + TEXTENTRY_TOP_PADDING;
+			bottom         = m_textEntryTop + textEntryBounds.top + textEntryBounds.height;
+		}
 
-		//We'll make sure that the remainder of the box fits
-		//the buttons just right - it will expand if it's too
-		//small, or shrink if it's too large
+		//The rest of the box fits the buttons just right
 
 		//We wouldn't want to perform 0-1 on a size_t now, would we?
 		float totalSpacing{0.F};
@@ -424,26 +471,39 @@ namespace spss {
 			totalSpacing = (m_buttons.size() - 1) * BUTTON_SPACING;
 		}
 
-		float heightNeeded{(m_buttons.size() * BUTTON_HEIGHT) +
-		                   totalSpacing};
+		m_buttonsTop = bottom + BUTTON_TOP_PADDING;
+
+		float height{m_buttonsTop + (m_buttons.size() * BUTTON_HEIGHT) + totalSpacing};
+		height += BUTTON_BOTTOM_PADDING;
 
-		heightNeeded += BUTTON_TOP_PADDING;
-		heightNeeded += BUTTON_BOTTOM_PADDING;
+		//The offsets are measured from the top of the outline, which
+		//sits outside of the rectangle
+		setHeight(height - 2 * m_rect.getOutlineThickness());
+	}
 
-		float diff{buttonBounds.height - heightNeeded};
+	////////////////////////////////////////////////////////////
+	void DialogPrompt::arrange() {
+		m_arrangeNeeded = false;
 
-		//If a resize is needed, we'll just call setHeight() and return.
-		//setHeight() will set m_alignment to true, so this function will
-		//be called again with the updated, correct size the next frame.
-		if (diff != 0) {
-			setHeight(size.y - diff);
-			return;
+		auto rectBounds{m_rect.getGlobalBounds()};
+
+		//For the purpose of aligning elements, we'll want to get the position of
+		//the upperleft most corner of m_rect. This is why we don't call m_rect.getPosition()
+		//(which would return the center of the box, since the origin is always centered)
+
+		sf::Vector2f pos{rectBounds.left, rectBounds.top};
+		auto         size{m_rect.getSize()};
+
+		m_title.setPosition({pos.x + TEXT_SIDE_PADDING, pos.y + TITLE_TOP_PADDING});
+
+		if (m_textEntry != nullptr) {
+			m_textEntry->setPosition({pos.x + TEXT_SIDE_PADDING, pos.y + m_textEntryTop});
 		}
 
 		float centerX{pos.x + size.x / 2};
 
 		for (size_t i{0}; i < m_buttons.size(); i++) {
-			float y{buttonBounds.top + (i * BUTTON_HEIGHT)};
+			float y{pos.y + m_buttonsTop + (i * BUTTON_HEIGHT)};
 			y += i * BUTTON_SPACING;
 			m_buttons[i].setPosition({centerX, y});
 		}
@@ -26,9 +26,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SPSS/Graphics/MulticolorText.h>
+#include <SPSS/Graphics/TextVertices.h>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
 #include <cmath>
+#include <memory>
 
 namespace spss {
 
@@ -46,7 +51,7 @@ namespace spss {
 	}
 
 	// Add a glyph quad to the vertex array
-	void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0) {
+	void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness) {
 		float padding = 1.0;
 
 		float left   = glyph.bounds.left - padding;
@@ -66,6 +71,128 @@ namespace spss {
 		vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top - outlineThickness, position.y + top - outlineThickness), color, sf::Vector2f(u2, v1)));
 		vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
 	}
+
+	// A glyph quad whose texture coordinates have to be packed with effect data
+	struct EffectQuad {
+		std::size_t firstVertex;
+		int         run;
+		std::size_t index;
+	};
+
+	// Runs longer than this wrap around, to keep enough precision in the packed texture coordinates
+	constexpr std::size_t MAX_EFFECT_RUN_LENGTH = 2048;
+
+	// Pack the effect run and the character's index within the run into the integer part of a glyph
+	// quad's normalized texture coordinates (i.e. whole multiples of the texture size, in pixels)
+	void packEffectQuad(sf::VertexArray& vertices, const EffectQuad& quad, const sf::Vector2f& textureSize) {
+		float runOffset   = static_cast<float>(quad.run) * textureSize.x;
+		float indexOffset = static_cast<float>(quad.index % MAX_EFFECT_RUN_LENGTH) * textureSize.y;
+
+		for (std::size_t i = quad.firstVertex; i < quad.firstVertex + 6; ++i) {
+			vertices[i].texCoords.x += runOffset;
+			vertices[i].texCoords.y += indexOffset;
+		}
+	}
+
+	// Effects are animated from this clock, shared by all texts
+	sf::Clock& effectClock() {
+		static sf::Clock clock;
+		return clock;
+	}
+
+	const char* EFFECT_VERTEX_SHADER = R"(
+		uniform float time;
+		uniform float effectTypes[8];
+		uniform vec4  effectParams[8]; // amplitude, frequency, start time, unused
+
+		vec3 hueToRgb(float h) {
+			return clamp(abs(fract(vec3(h) + vec3(0.0, 2.0 / 3.0, 1.0 / 3.0)) * 6.0 - 3.0) - 1.0, 0.0, 1.0);
+		}
+
+		float random(vec2 seed) {
+			return fract(sin(dot(seed, vec2(12.9898, 78.233))) * 43758.5453);
+		}
+
+		void main() {
+			vec4  texCoord = gl_TextureMatrix[0] * gl_MultiTexCoord0;
+			float run      = floor(texCoord.x);
+			float index    = floor(texCoord.y);
+			texCoord.xy -= vec2(run, index);
+
+			vec4 vertex = gl_Vertex;
+			vec4 color  = gl_Color;
+
+			if (run > 0.5) {
+				int   i         = int(run) - 1;
+				float type      = effectTypes[i];
+				float amplitude = effectParams[i].x;
+				float frequency = effectParams[i].y;
+				float t         = time - effectParams[i].z;
+
+				if (type < 1.5) { // Wave
+					vertex.y += amplitude * sin(6.2831853 * (frequency * t - index * 0.1));
+				}
+				else if (type < 2.5) { // Pulse
+					color.a *= 1.0 - amplitude * (0.5 + 0.5 * sin(6.2831853 * frequency * t));
+				}
+				else if (type < 3.5) { // Shake
+					float tick = floor(t * frequency);
+					vertex.x += amplitude * (2.0 * random(vec2(index, tick)) - 1.0);
+					vertex.y += amplitude * (2.0 * random(vec2(tick, index)) - 1.0);
+				}
+				else if (type < 4.5) { // Rainbow
+					color.rgb = hueToRgb(fract(frequency * t + index * 0.05));
+				}
+				else { // Typewriter
+					color.a *= step(index, t * frequency);
+				}
+			}
+
+			gl_Position    = gl_ModelViewProjectionMatrix * vertex;
+			gl_TexCoord[0] = texCoord;
+			gl_FrontColor  = color;
+		}
+	)";
+
+	const char* EFFECT_FRAGMENT_SHADER = R"(
+		uniform sampler2D texture;
+
+		void main() {
+			gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);
+		}
+	)";
+
+	// The shader shared by all texts with effects. It's released explicitly, since
+	// destroying it along with the other statics may happen after the GL context is gone.
+	struct EffectShader {
+		std::unique_ptr<sf::Shader> shader;
+		bool                        loaded = false;
+	};
+
+	EffectShader& effectShaderState() {
+		static EffectShader state;
+		return state;
+	}
+
+	// The shader shared by all texts with effects, or NULL if shaders aren't available
+	sf::Shader* effectShader() {
+		EffectShader& state = effectShaderState();
+
+		if (!state.loaded) {
+			state.loaded = true;
+			if (sf::Shader::isAvailable()) {
+				state.shader = std::make_unique<sf::Shader>();
+				if (state.shader->loadFromMemory(EFFECT_VERTEX_SHADER, EFFECT_FRAGMENT_SHADER)) {
+					state.shader->setUniform("texture", sf::Shader::CurrentTexture);
+				}
+				else {
+					state.shader.reset();
+				}
+			}
+		}
+
+		return state.shader.get();
+	}
 } // namespace spss
 
 namespace spss {
@@ -80,15 +207,22 @@ namespace spss {
 	              m_style(Regular),
 	              m_styleFillColor(255, 255, 255),
 	              m_styleOutlineColor(0, 0, 0),
+	              m_defaultFillColor(255, 255, 255),
+	              m_defaultOutlineColor(0, 0, 0),
+	              m_defaultOutlineThickness(0),
 	              m_styleOutlineThickness(0),
 	              m_vertices(sf::Triangles),
 	              m_outlineVertices(sf::Triangles),
 	              m_bounds(),
 	              m_geometryNeedUpdate(false),
+	              m_layoutStart(sf::String::InvalidPos),
+	              m_layoutStates(),
 	              m_fillColors(),
 	              m_outlineColors(),
 	              m_outlineThicknesses(),
-	              m_vertexIndeces() {
+	              m_effects(),
+	              m_effectRuns(),
+	              m_effectTextureSize() {
 	}
 
 	////////////////////////////////////////////////////////////
@@ -103,32 +237,62 @@ namespace spss {
 	              m_style(Regular),
 	              m_styleFillColor(255, 255, 255),
 	              m_styleOutlineColor(0, 0, 0),
+	              m_defaultFillColor(255, 255, 255),
+	              m_defaultOutlineColor(0, 0, 0),
+	              m_defaultOutlineThickness(0),
 	              m_styleOutlineThickness(0),
 	              m_vertices(sf::Triangles),
 	              m_outlineVertices(sf::Triangles),
 	              m_bounds(),
 	              m_geometryNeedUpdate(true),
+	              m_layoutStart(sf::String::InvalidPos),
+	              m_layoutStates(),
 	              m_fillColors(),
 	              m_outlineColors(),
 	              m_outlineThicknesses(),
-	              m_vertexIndeces() {
+	              m_effects(),
+	              m_effectRuns(),
+	              m_effectTextureSize() {
 	}
 
 	////////////////////////////////////////////////////////////
 	//When the string is changed, we're going to have to clear
-	//all colour/thickness data, because the positions will no
-	//longer be accurate. They must be re-set if needed.
+	//all colour/thickness/effect data, because the positions will
+	//no longer be accurate. They must be re-set if needed.
 	////////////////////////////////////////////////////////////
 	void MulticolorText::setString(const sf::String& string) {
 		if (m_string != string) {
 			m_fillColors.clear();
 			m_outlineColors.clear();
 			m_outlineThicknesses.clear();
+			m_effects.clear();
+			m_effectRuns.clear();
 			m_string             = string;
 			m_geometryNeedUpdate = true;
 		}
 	}
 
+	////////////////////////////////////////////////////////////
+	void MulticolorText::replace(std::size_t position, std::size_t count, const sf::String& string) {
+		position = std::min(position, m_string.getSize());
+		count    = std::min(count, m_string.getSize() - position);
+		if (count == 0 && string.isEmpty())
+			return;
+
+		//The characters before the replaced ones keep their geometry,
+		//unless it used colors or effects which are cleared now
+		if (!m_fillColors.empty() || !m_outlineColors.empty() || !m_outlineThicknesses.empty() || !m_effects.empty())
+			m_geometryNeedUpdate = true;
+
+		m_fillColors.clear();
+		m_outlineColors.clear();
+		m_outlineThicknesses.clear();
+		m_effects.clear();
+		m_effectRuns.clear();
+		m_string.replace(position, count, string);
+		m_layoutStart = std::min(m_layoutStart, position);
+	}
+
 	////////////////////////////////////////////////////////////
 	void MulticolorText::setFont(const sf::Font& font) {
 		if (m_font != &font) {
@@ -206,6 +370,30 @@ namespace spss {
 		m_styleOutlineColor = color;
 	}
 
+	////////////////////////////////////////////////////////////
+	void MulticolorText::setDefaultFillColor(const sf::Color& color) {
+		if (m_defaultFillColor != color) {
+			m_defaultFillColor   = color;
+			m_geometryNeedUpdate = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MulticolorText::setDefaultOutlineColor(const sf::Color& color) {
+		if (m_defaultOutlineColor != color) {
+			m_defaultOutlineColor = color;
+			m_geometryNeedUpdate  = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MulticolorText::setDefaultOutlineThickness(float thickness) {
+		if (m_defaultOutlineThickness != thickness) {
+			m_defaultOutlineThickness = thickness;
+			m_geometryNeedUpdate      = true;
+		}
+	}
+
 	////////////////////////////////////////////////////////////
 	void MulticolorText::setOutlineColor(const sf::Color& color,
 	                                     size_t           _startPos,
@@ -223,8 +411,7 @@ namespace spss {
 			}
 		}
 
-		//Since m_vertexIndeces only caches the positions of letters and the indeces of the first
-		//vertex used to draw them, and doesn't account for outlines, we'll have to update the geometry
+		//The outline colors are baked into the vertices, so we'll have to update the geometry
 		m_geometryNeedUpdate = true;
 	}
 
@@ -252,6 +439,83 @@ namespace spss {
 		m_geometryNeedUpdate = true;
 	}
 
+	////////////////////////////////////////////////////////////
+	MulticolorText::Effect MulticolorText::Effect::wave(float _amplitude, float _frequency) {
+		return {Wave, _amplitude, _frequency};
+	}
+
+	////////////////////////////////////////////////////////////
+	MulticolorText::Effect MulticolorText::Effect::pulse(float _depth, float _frequency) {
+		return {Pulse, _depth, _frequency};
+	}
+
+	////////////////////////////////////////////////////////////
+	MulticolorText::Effect MulticolorText::Effect::shake(float _amplitude, float _frequency) {
+		return {Shake, _amplitude, _frequency};
+	}
+
+	////////////////////////////////////////////////////////////
+	MulticolorText::Effect MulticolorText::Effect::rainbow(float _frequency) {
+		return {Rainbow, 0.f, _frequency};
+	}
+
+	////////////////////////////////////////////////////////////
+	MulticolorText::Effect MulticolorText::Effect::typewriter(float _charsPerSecond) {
+		return {Typewriter, 0.f, _charsPerSecond};
+	}
+
+	////////////////////////////////////////////////////////////
+	void MulticolorText::setEffect(const Effect& effect,
+	                               size_t        _startPos,
+	                               size_t        _endPos) {
+		if (m_string.isEmpty()) {
+			return;
+		}
+
+		if (_endPos == 0) {
+			_endPos = m_string.getSize() - 1;
+		}
+
+		if (effect.type == Effect::None) {
+			for (std::size_t i = _startPos; i <= _endPos; ++i) {
+				m_effects.erase(i);
+			}
+			m_geometryNeedUpdate = true;
+			return;
+		}
+
+		if (m_effectRuns.size() >= MaxEffectRuns) {
+			return;
+		}
+
+		m_effectRuns.push_back({effect, _startPos, effectClock().getElapsedTime().asSeconds()});
+		int run = static_cast<int>(m_effectRuns.size());
+
+		for (std::size_t i = _startPos; i <= _endPos; ++i) {
+			m_effects[i] = run;
+		}
+
+		m_geometryNeedUpdate = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MulticolorText::clearEffects() {
+		if (m_effectRuns.empty()) {
+			return;
+		}
+
+		m_effects.clear();
+		m_effectRuns.clear();
+		m_geometryNeedUpdate = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MulticolorText::releaseEffectShader() {
+		EffectShader& state = effectShaderState();
+		state.shader.reset();
+		state.loaded = false;
+	}
+
 	////////////////////////////////////////////////////////////
 	const sf::String& MulticolorText::getString() const {
 		return m_string;
@@ -285,7 +549,7 @@ namespace spss {
 	////////////////////////////////////////////////////////////
 	const sf::Color MulticolorText::getFillColor(size_t _index) const {
 		if (m_fillColors.empty() || (!m_fillColors.count(_index))) {
-			return {255, 255, 255};
+			return m_defaultFillColor;
 		}
 
 		return m_fillColors[_index];
@@ -294,7 +558,7 @@ namespace spss {
 	////////////////////////////////////////////////////////////
 	const sf::Color MulticolorText::getOutlineColor(size_t _index) const {
 		if (m_outlineColors.empty() || (!m_outlineColors.count(_index))) {
-			return {0, 0, 0};
+			return m_defaultOutlineColor;
 		}
 
 		return m_outlineColors[_index];
@@ -304,7 +568,7 @@ namespace spss {
 	float MulticolorText::getOutlineThickness(size_t _index) const {
 		if (m_outlineThicknesses.empty() ||
 		    (!m_outlineThicknesses.count(_index))) {
-			return 0;
+			return m_defaultOutlineThickness;
 		}
 
 		return m_outlineThicknesses[_index];
@@ -366,6 +630,62 @@ namespace spss {
 		return position;
 	}
 
+	////////////////////////////////////////////////////////////
+	void MulticolorText::findCharacterPositions(std::vector<sf::Vector2f>& positions, std::size_t first) const {
+		// Keep the positions before the first changed character, and
+		// carry on from its own
+		first                 = positions.empty() ? 0 : std::min({first, positions.size() - 1, m_string.getSize()});
+		sf::Vector2f position = first > 0 ? positions[first] : sf::Vector2f();
+		positions.resize(first);
+
+		// Make sure that we have a valid font
+		if (!m_font) {
+			positions.resize(m_string.getSize() + 1);
+			return;
+		}
+
+		if (first == 0)
+			positions.reserve(m_string.getSize() + 1);
+
+		// Precompute the variables needed by the algorithm
+		bool  isBold          = m_style & Bold;
+		float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+		float letterSpacing   = (whitespaceWidth / 3.f) * (m_letterSpacingFactor - 1.f);
+		whitespaceWidth += letterSpacing;
+		float lineSpacing = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+
+		// Same as findCharacterPos, except every intermediate
+		// position is kept
+		sf::Uint32 prevChar = first > 0 ? m_string[first - 1] : 0;
+		for (std::size_t i = first; i < m_string.getSize(); ++i) {
+			sf::Uint32 curChar = m_string[i];
+			positions.push_back(position);
+
+			// Apply the kerning offset
+			position.x += m_font->getKerning(prevChar, curChar, m_characterSize);
+			prevChar = curChar;
+
+			// Handle special characters
+			switch (curChar) {
+			case ' ':
+				position.x += whitespaceWidth;
+				continue;
+			case '\t':
+				position.x += whitespaceWidth * 4;
+				continue;
+			case '\n':
+				position.y += lineSpacing;
+				position.x = 0;
+				continue;
+			}
+
+			// For regular characters, add the advance offset of the glyph
+			position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+		}
+
+		positions.push_back(position);
+	}
+
 	////////////////////////////////////////////////////////////
 	sf::FloatRect MulticolorText::getLocalBounds() const {
 		ensureGeometryUpdate();
@@ -382,13 +702,36 @@ namespace spss {
 	void MulticolorText::draw(sf::RenderTarget& target,
 	                          sf::RenderStates  states) const {
 		if (m_font) {
+			//The packed effect data is relative to the size of the font's
+			//texture, so it has to be repacked if the texture has grown
+			if (!m_effects.empty() &&
+			    m_font->getTexture(m_characterSize).getSize() != m_effectTextureSize) {
+				m_geometryNeedUpdate = true;
+			}
+
 			ensureGeometryUpdate();
 
 			states.transform *= getTransform();
 			states.texture = &m_font->getTexture(m_characterSize);
 
+			sf::Shader* shader = m_effects.empty() ? NULL : effectShader();
+			if (shader) {
+				float          types[MaxEffectRuns] = {};
+				sf::Glsl::Vec4 params[MaxEffectRuns];
+				for (std::size_t i = 0; i < m_effectRuns.size(); ++i) {
+					const EffectRun& run = m_effectRuns[i];
+					types[i]             = static_cast<float>(run.effect.type);
+					params[i]            = sf::Glsl::Vec4(run.effect.amplitude, run.effect.frequency, run.startTime, 0.f);
+				}
+
+				shader->setUniform("time", effectClock().getElapsedTime().asSeconds());
+				shader->setUniformArray("effectTypes", types, MaxEffectRuns);
+				shader->setUniformArray("effectParams", params, MaxEffectRuns);
+				states.shader = shader;
+			}
+
 			// Only draw the outline if there is something to draw
-			if (!m_outlineThicknesses.empty()) {
+			if (m_outlineVertices.getVertexCount() > 0) {
 				target.draw(m_outlineVertices, states);
 			}
 
@@ -402,18 +745,41 @@ namespace spss {
 			return;
 
 		// Do nothing, if geometry has not changed and the font texture has not changed
-		if (!m_geometryNeedUpdate)
+		if (!m_geometryNeedUpdate && m_layoutStart == sf::String::InvalidPos)
 			return;
 
+		// If only part of the string was replaced, the characters
+		// before it keep their geometry, and the layout carries on
+		// from the state it was in before the first replaced one
+		std::size_t first = 0;
+		if (!m_geometryNeedUpdate && !m_layoutStates.empty())
+			first = std::min(m_layoutStart, m_layoutStates.size() - 1);
+
 		// Mark geometry as updated
 		m_geometryNeedUpdate = false;
-
-		// Clear the previous geometry
-		m_vertexIndeces.clear();
-		m_vertices.clear();
-		m_outlineVertices.clear();
+		m_layoutStart        = sf::String::InvalidPos;
+
+		LayoutState start = {sf::Vector2f(0.f, static_cast<float>(m_characterSize)),
+		                     0,
+		                     sf::Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize)),
+		                     sf::Vector2f(0.f, 0.f),
+		                     0,
+		                     0};
+		if (first > 0)
+			start = m_layoutStates[first];
+
+		// Clear the previous geometry, from the first changed character
+		m_vertices.resize(start.vertexCount);
+		m_outlineVertices.resize(start.outlineVertexCount);
+		m_layoutStates.resize(first);
 		m_bounds = sf::FloatRect();
 
+		// Glyph quads that belong to an effect run. Since loading glyphs may grow the font's
+		// texture, the effect data is packed once all glyphs have been added.
+		bool                    packEffects = !m_effects.empty() && effectShader();
+		std::vector<EffectQuad> effectQuads;
+		std::vector<EffectQuad> outlineEffectQuads;
+
 		// No text: nothing to draw
 		if (m_string.isEmpty())
 			return;
@@ -437,16 +803,18 @@ namespace spss {
 		float letterSpacing   = (whitespaceWidth / 3.f) * (m_letterSpacingFactor - 1.f);
 		whitespaceWidth += letterSpacing;
 		float lineSpacing = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-		float x           = 0.f;
-		float y           = static_cast<float>(m_characterSize);
+		float x           = start.pen.x;
+		float y           = start.pen.y;
 
 		// Create one quad for each character
-		float      minX     = static_cast<float>(m_characterSize);
-		float      minY     = static_cast<float>(m_characterSize);
-		float      maxX     = 0.f;
-		float      maxY     = 0.f;
-		sf::Uint32 prevChar = 0;
-		for (std::size_t i = 0; i < m_string.getSize(); ++i) {
+		float      minX     = start.minBounds.x;
+		float      minY     = start.minBounds.y;
+		float      maxX     = start.maxBounds.x;
+		float      maxY     = start.maxBounds.y;
+		sf::Uint32 prevChar = start.prevChar;
+		for (std::size_t i = first; i < m_string.getSize(); ++i) {
+			m_layoutStates.push_back({sf::Vector2f(x, y), prevChar, sf::Vector2f(minX, minY), sf::Vector2f(maxX, maxY), m_vertices.getVertexCount(), m_outlineVertices.getVertexCount()});
+
 			sf::Uint32 curChar = m_string[i];
 
 			// Skip the \r char to avoid weird graphical issues
@@ -454,21 +822,25 @@ namespace spss {
 				continue;
 
 			//////////////////////////////////////////////////////////////////////
-			if (!m_fillColors.count(i)) {
-				m_fillColors.insert(std::make_pair(i, sf::Color(255, 255, 255)));
-			}
-
-			if (!m_outlineColors.count(i)) {
-				m_outlineColors.insert(std::make_pair(i, sf::Color(0, 0, 0)));
-			}
-
-			if (!m_outlineThicknesses.count(i)) {
-				m_outlineThicknesses.insert(std::make_pair(i, 0));
+			//Characters without their own colors use the default ones, which
+			//aren't stored in the maps since they may change later on
+			std::map<int, sf::Color>::const_iterator fillColor        = m_fillColors.find(i);
+			std::map<int, sf::Color>::const_iterator outlineColor     = m_outlineColors.find(i);
+			std::map<int, float>::const_iterator     outlineThickness = m_outlineThicknesses.find(i);
+
+			sf::Color curFillColor        = fillColor != m_fillColors.end() ? fillColor->second : m_defaultFillColor;
+			sf::Color curOutlineColor     = outlineColor != m_outlineColors.end() ? outlineColor->second : m_defaultOutlineColor;
+			float     curOutlineThickness = outlineThickness != m_outlineThicknesses.end() ? outlineThickness->second : m_defaultOutlineThickness;
+
+			int         curEffectRun   = 0;
+			std::size_t curEffectIndex = 0;
+			if (packEffects) {
+				std::map<int, int>::const_iterator effect = m_effects.find(i);
+				if (effect != m_effects.end()) {
+					curEffectRun   = effect->second;
+					curEffectIndex = i - m_effectRuns[curEffectRun - 1].startPos;
+				}
 			}
-
-			sf::Color curFillColor        = m_fillColors[i];
-			sf::Color curOutlineColor     = m_outlineColors[i];
-			float     curOutlineThickness = m_outlineThicknesses[i];
 			//////////////////////////////////////////////////////////////////////
 
 			// Apply the kerning offset
@@ -531,6 +903,9 @@ namespace spss {
 				// Add the outline glyph to the vertices
 				addGlyphQuad(m_outlineVertices, sf::Vector2f(x, y), curOutlineColor, glyph, italicShear, curOutlineThickness);
 
+				if (curEffectRun != 0)
+					outlineEffectQuads.push_back({m_outlineVertices.getVertexCount() - 6, curEffectRun, curEffectIndex});
+
 				// Update the current bounds with the outlined glyph bounds
 				minX = std::min(minX, x + left - italicShear * bottom - curOutlineThickness);
 				maxX = std::max(maxX, x + right - italicShear * top - curOutlineThickness);
@@ -544,7 +919,8 @@ namespace spss {
 			// Add the glyph to the vertices
 			addGlyphQuad(m_vertices, sf::Vector2f(x, y), curFillColor, glyph, italicShear);
 
-			m_vertexIndeces.insert(std::make_pair(i, m_vertices.getVertexCount() - 6));
+			if (curEffectRun != 0)
+				effectQuads.push_back({m_vertices.getVertexCount() - 6, curEffectRun, curEffectIndex});
 
 			// Update the current bounds with the non outlined glyph bounds
 			if (curOutlineThickness == 0) {
@@ -563,6 +939,9 @@ namespace spss {
 			x += glyph.advance + letterSpacing;
 		}
 
+		// The state at the end is where characters added later start
+		m_layoutStates.push_back({sf::Vector2f(x, y), prevChar, sf::Vector2f(minX, minY), sf::Vector2f(maxX, maxY), m_vertices.getVertexCount(), m_outlineVertices.getVertexCount()});
+
 		// If we're using the underlined style, add the last line
 		if (isUnderlined && (x > 0)) {
 			addLine(m_vertices, x, y, m_styleFillColor, underlineOffset, underlineThickness);
@@ -579,6 +958,16 @@ namespace spss {
 				addLine(m_outlineVertices, x, y, m_styleOutlineColor, strikeThroughOffset, underlineThickness, m_styleOutlineThickness);
 		}
 
+		// Pack the effect data now that the font's texture has its final size
+		m_effectTextureSize = m_font->getTexture(m_characterSize).getSize();
+		sf::Vector2f textureSize(m_effectTextureSize);
+
+		for (std::size_t i = 0; i < effectQuads.size(); ++i)
+			packEffectQuad(m_vertices, effectQuads[i], textureSize);
+
+		for (std::size_t i = 0; i < outlineEffectQuads.size(); ++i)
+			packEffectQuad(m_outlineVertices, outlineEffectQuads[i], textureSize);
+
 		// Update the bounding rectangle
 		m_bounds.left   = minX;
 		m_bounds.top    = minY;
@@ -1,7 +1,23 @@
 #include <SPSS/Graphics/Scrollbar.h>
+#include <SPSS/System/InputSnapshot.h>
 #include <SPSS/Util/Input.h>
 #include <SPSS/Util/Math.h>
 
+#include <algorithm>
+#include <cmath>
+
+//How quickly wheel scrolling slows down, per millisecond; it loses
+//about two thirds of its speed every 100ms
+constexpr float SCROLL_FRICTION{0.01F};
+
+//The time it takes the view to cover two thirds of the way to the
+//wheel's target, in milliseconds
+constexpr float SCROLL_SMOOTHING{40.F};
+
+//Longer gaps between updates (e.g. while the owning state is
+//covered by another one) are treated as this many milliseconds
+constexpr float MAX_SCROLL_STEP{100.F};
+
 namespace spss {
 
 	////////////////////////////////////////////////////////////
@@ -23,7 +39,20 @@ namespace spss {
 	              m_inner{},
 	              m_minCenterY{_min},
 	              m_maxCenterY{_max},
-	              m_anchor{Scrollbar::Anchor::NONE} {
+	              m_anchor{Scrollbar::Anchor::NONE},
+	              m_centerY{_min},
+	              m_targetCenterY{_min},
+	              m_velocity{0},
+	              m_pendingWheel{0},
+	              m_clock{},
+	              m_visibleTop{0},
+	              m_visibleBottom{0},
+	              m_viewVelocity{0},
+	              m_onVisibleRangeChange{nullptr},
+	              m_onPrefetch{nullptr},
+	              m_prefetchDistance{0},
+	              m_prefetchedTop{0},
+	              m_prefetchedBottom{0} {
 		m_outer.setOutlineThickness(-1);
 		m_outer.setFillColor(sf::Color::Transparent);
 		setColor(m_color);
@@ -74,28 +103,31 @@ namespace spss {
 		float ratio{scrollbarHeight / totalHeight};
 		m_inner.setSize({_size.x, scrollbarHeight * ratio});
 
+		//The content may have changed, so whatever was prepared
+		//will be asked for again
+		m_prefetchedTop    = m_visibleTop;
+		m_prefetchedBottom = m_visibleBottom;
+
 		//If we have a hard/soft anchor, we can skip the rest
 		if (m_anchor == Anchor::HARD || softAnchorNeeded) {
 			snapToBottom();
+			calculateNewViewCenter();
 			return;
 		}
 
-		//In order to avoid resetting the inner Y when unneccessary, we'll
-		//keep it and adjust it only if it goes out of range.
-		float innerY{m_inner.getPosition().y};
-		float minY{m_outer.getPosition().y};
-		float maxY{minY};
+		//We'll keep the view where it was, moving it only if it's
+		//out of range, so that content can be appended (e.g. the
+		//next page of a list) without the view jumping.
+		placeThumb(m_centerY);
 
-		maxY += m_outer.getGlobalBounds().height;
-		maxY -= m_inner.getGlobalBounds().height;
-		if (innerY > maxY) {
-			innerY = maxY;
-		}
-		if (innerY < minY) {
-			innerY = minY;
-		}
+		//Wheel scrolling carries on from there, within the new range
+		m_centerY       = getThumbCenterY();
+		m_targetCenterY = std::clamp(m_targetCenterY, m_minCenterY, std::max(m_minCenterY, m_maxCenterY));
 
-		m_inner.setPosition({_pos.x, innerY});
+		//The view may have been reset along with the scrollbar, so
+		//it's moved back to match right away rather than on the
+		//next update
+		calculateNewViewCenter();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -117,38 +149,48 @@ namespace spss {
 			m_dragging = false;
 		}
 
-		if (!m_scrollWithWheel) {
+		if (!m_scrollWithWheel || !m_active) {
 			return;
 		}
 
-		if (_event.type == sf::Event::MouseWheelMoved) {
+		//SFML reports every wheel notch as a MouseWheelMoved as well,
+		//but only MouseWheelScrolled has the fractional deltas of
+		//high-resolution wheels and touchpads
+		if (_event.type == sf::Event::MouseWheelScrolled &&
+		    _event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
 			sf::FloatRect blankBounds{};
 
 			if (_mouseBounds != blankBounds) {
-				sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-				sf::Vector2f pixelPos{m_window->mapPixelToCoords(mousePos, m_backgroundView)};
+				sf::Vector2f pixelPos{InputSnapshot::get_instance().getMousePosition(*m_window, m_backgroundView)};
 
 				if (!_mouseBounds.contains(pixelPos.x, pixelPos.y)) {
 					return;
 				}
 			}
 
-			if (_event.mouseWheel.delta > 0) {
-				scroll(true);
-			}
-			else if (_event.mouseWheel.delta < 0) {
-				scroll(false);
-			}
+			//Applied in the next update, so that a burst of events
+			//only changes the target once
+			m_pendingWheel += _event.mouseWheelScroll.delta;
 		}
 	}
 
 	////////////////////////////////////////////////////////////
 	void Scrollbar::update() {
+		float elapsed{std::min(m_clock.restart().asSeconds() * 1000.F, MAX_SCROLL_STEP)};
+
 		if (!m_active) {
-			return;
+			m_pendingWheel = 0;
+		}
+		else if (m_dragging) {
+			drag();
+			stopGliding();
 		}
-		drag();
+		else {
+			glide(elapsed);
+		}
+
 		calculateNewViewCenter();
+		publishVisibleRange(elapsed);
 	}
 
 	////////////////////////////////////////////////////////////
@@ -189,6 +231,7 @@ namespace spss {
 		float lowerLimit{outerPos.y};
 		innerPos.y = lowerLimit;
 		m_inner.setPosition({outerPos.x, innerPos.y});
+		stopGliding();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -200,6 +243,42 @@ namespace spss {
 		float upperLimit{outerPos.y + outerBounds.height - innerBounds.height};
 		innerPos.y = upperLimit;
 		m_inner.setPosition({outerPos.x, innerPos.y});
+		stopGliding();
+	}
+
+	////////////////////////////////////////////////////////////
+	void Scrollbar::scrollTo(float _centerY) {
+		placeThumb(_centerY);
+		stopGliding();
+		calculateNewViewCenter();
+	}
+
+	////////////////////////////////////////////////////////////
+	void Scrollbar::setVisibleRangeCallback(Function<float, float, float> _callback) {
+		m_onVisibleRangeChange = std::move(_callback);
+	}
+
+	////////////////////////////////////////////////////////////
+	void Scrollbar::setPrefetchCallback(float _distance, Function<float, float> _callback) {
+		m_prefetchDistance = _distance;
+		m_onPrefetch       = std::move(_callback);
+		m_prefetchedTop    = m_visibleTop;
+		m_prefetchedBottom = m_visibleBottom;
+	}
+
+	////////////////////////////////////////////////////////////
+	float Scrollbar::getVisibleTop() const {
+		return m_visibleTop;
+	}
+
+	////////////////////////////////////////////////////////////
+	float Scrollbar::getVisibleBottom() const {
+		return m_visibleBottom;
+	}
+
+	////////////////////////////////////////////////////////////
+	float Scrollbar::getScrollVelocity() const {
+		return m_viewVelocity;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -240,8 +319,7 @@ namespace spss {
 			return false;
 		}
 
-		sf::Vector2i mousePos = sf::Mouse::getPosition(*m_window);
-		sf::Vector2f pixelPos{m_window->mapPixelToCoords(mousePos, m_backgroundView)};
+		sf::Vector2f pixelPos{InputSnapshot::get_instance().getMousePosition(*m_window, m_backgroundView)};
 
 		if (m_outer.getGlobalBounds().contains(pixelPos.x, pixelPos.y)) {
 			return true;
@@ -251,33 +329,50 @@ namespace spss {
 	}
 
 	////////////////////////////////////////////////////////////
-	void Scrollbar::scroll(bool _up) {
-		if (!m_active) {
+	void Scrollbar::glide(float _elapsed) {
+		//Every notch adds enough speed to coast half a page, whether
+		//it arrives in one event or in many fractional ones
+		if (m_pendingWheel != 0) {
+			m_velocity -= m_pendingWheel * (m_outer.getSize().y / 2) * SCROLL_FRICTION;
+			m_pendingWheel = 0;
+		}
+
+		if (m_velocity == 0 && m_centerY == m_targetCenterY) {
 			return;
 		}
 
-		auto  pos{m_inner.getPosition()};
-		float min{m_outer.getPosition().y};
-		float max{m_outer.getPosition().y + m_outer.getGlobalBounds().height};
-		max -= m_inner.getGlobalBounds().height;
+		//Integrating the exponential decay exactly, rather than one
+		//step at a time, gives the same result for any update rate
+		if (m_velocity != 0) {
+			float decay{std::exp(-SCROLL_FRICTION * _elapsed)};
+			m_targetCenterY += (m_velocity / SCROLL_FRICTION) * (1.F - decay);
+			m_velocity *= decay;
 
-		if (_up) {
-			pos.y -= m_inner.getGlobalBounds().height / 2;
-		}
-		else {
-			pos.y += m_inner.getGlobalBounds().height / 2;
+			//Stop once there's less than half a pixel left to coast
+			if (std::fabs(m_velocity / SCROLL_FRICTION) < 0.5F) {
+				m_velocity = 0;
+			}
 		}
 
-		m_inner.setPosition(pos);
-
-		if (atTop()) {
-			pos.y = min;
+		float maxCenterY{std::max(m_minCenterY, m_maxCenterY)};
+		if (m_targetCenterY <= m_minCenterY || m_targetCenterY >= maxCenterY) {
+			m_targetCenterY = std::clamp(m_targetCenterY, m_minCenterY, maxCenterY);
+			m_velocity      = 0;
 		}
-		else if (pos.y >= max) {
-			pos.y = max;
+
+		m_centerY += (m_targetCenterY - m_centerY) * (1.F - std::exp(-_elapsed / SCROLL_SMOOTHING));
+		if (std::fabs(m_targetCenterY - m_centerY) < 0.5F) {
+			m_centerY = m_targetCenterY;
 		}
 
-		m_inner.setPosition(pos);
+		placeThumb(m_centerY);
+	}
+
+	////////////////////////////////////////////////////////////
+	void Scrollbar::stopGliding() {
+		m_centerY       = getThumbCenterY();
+		m_targetCenterY = m_centerY;
+		m_velocity      = 0;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -286,8 +381,7 @@ namespace spss {
 			return;
 		}
 
-		auto pos{sf::Mouse::getPosition(*m_window)};
-		auto mousePos{m_window->mapPixelToCoords(pos, m_backgroundView)};
+		auto mousePos{InputSnapshot::get_instance().getMousePosition(*m_window, m_backgroundView)};
 
 		//Just some aliases for readability
 		auto outerPos{m_outer.getPosition()};
@@ -317,6 +411,14 @@ namespace spss {
 			return;
 		}
 
+		//Move the view to wherever the scrollbar is
+		auto c{m_scrollView.getCenter()};
+		c.y = getThumbCenterY();
+		m_scrollView.setCenter(c);
+	}
+
+	////////////////////////////////////////////////////////////
+	float Scrollbar::getThumbCenterY() const {
 		float innerY{m_inner.getPosition().y};
 
 		//First, we'll calculate the decimal percentage (between 0 and 1)
@@ -328,6 +430,11 @@ namespace spss {
 		float maxY{minY + m_outer.getGlobalBounds().height};
 		maxY -= m_inner.getGlobalBounds().height;
 
+		//A scrollbar that fills its whole track can't move
+		if (maxY <= minY) {
+			return m_minCenterY;
+		}
+
 		//The formula is: percentage = (value - min) / (max - min)
 		float p{(innerY - minY) / (maxY - minY)};
 
@@ -337,11 +444,58 @@ namespace spss {
 		//1 corresponds to the m_maxCenterY
 		//
 		//The formula is: value = ((max - min) * percentage) + min
-		float newCenterY{((m_maxCenterY - m_minCenterY) * p) + m_minCenterY};
+		return ((m_maxCenterY - m_minCenterY) * p) + m_minCenterY;
+	}
 
-		//And now we finally set the center to the newly calculated value
-		auto c{m_scrollView.getCenter()};
-		c.y = newCenterY;
-		m_scrollView.setCenter(c);
+	////////////////////////////////////////////////////////////
+	void Scrollbar::placeThumb(float _centerY) {
+		float minY{m_outer.getPosition().y};
+		float maxY{minY + m_outer.getGlobalBounds().height};
+		maxY -= m_inner.getGlobalBounds().height;
+
+		//This is the inverse of getThumbCenterY
+		float p{0};
+		if (m_maxCenterY > m_minCenterY) {
+			p = (_centerY - m_minCenterY) / (m_maxCenterY - m_minCenterY);
+			p = std::min(std::max(p, 0.F), 1.F);
+		}
+
+		m_inner.setPosition({m_outer.getPosition().x, minY + ((maxY - minY) * p)});
+	}
+
+	////////////////////////////////////////////////////////////
+	void Scrollbar::publishVisibleRange(float _elapsed) {
+		float top{m_scrollView.getCenter().y - m_scrollView.getSize().y / 2};
+		float bottom{top + m_scrollView.getSize().y};
+
+		//Several updates can run within the same millisecond, in
+		//which case the last speed still holds
+		float velocity{m_viewVelocity};
+		if (_elapsed > 0) {
+			velocity = (top - m_visibleTop) / _elapsed;
+		}
+
+		bool changed{top != m_visibleTop || bottom != m_visibleBottom || velocity != m_viewVelocity};
+
+		m_visibleTop    = top;
+		m_visibleBottom = bottom;
+		m_viewVelocity  = velocity;
+
+		if (changed && m_onVisibleRangeChange != nullptr) {
+			m_onVisibleRangeChange(top, bottom, velocity);
+		}
+
+		if (m_onPrefetch == nullptr) {
+			return;
+		}
+
+		if (velocity >= 0 && bottom + m_prefetchDistance / 2 > m_prefetchedBottom) {
+			m_prefetchedBottom = bottom + m_prefetchDistance;
+			m_onPrefetch(bottom, m_prefetchedBottom);
+		}
+		if (velocity <= 0 && top - m_prefetchDistance / 2 < m_prefetchedTop) {
+			m_prefetchedTop = top - m_prefetchDistance;
+			m_onPrefetch(m_prefetchedTop, top);
+		}
 	}
 } // namespace spss
@@ -0,0 +1,702 @@
+#include <SPSS/Graphics/TextArea.h>
+#include <SPSS/System/InputSnapshot.h>
+#include <SPSS/Util/Coordinates.h>
+#include <SPSS/Util/Input.h>
+#include <SPSS/Util/Unicode.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float SCROLLBAR_WIDTH{10.F};
+constexpr float TEXT_PADDING{4.F};
+constexpr float CARET_WIDTH{2.F};
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	TextArea::TextArea(const sf::Vector2f& _size,
+	                   const sf::Vector2f& _position,
+	                   const sf::Font&     _font,
+	                   const unsigned int  _charSize,
+	                   const std::string&  _str)
+	            : m_font{_font},
+	              m_charSize{_charSize},
+	              m_lines{},
+	              m_nextLineId{1},
+	              m_rows{},
+	              m_measureText{},
+	              m_rectangle{},
+	              m_caret{},
+	              m_highlight{sf::Triangles},
+	              m_textFillColor{sf::Color::White},
+	              m_caretPos{0, 0},
+	              m_anchorPos{0, 0},
+	              m_preferredX{0},
+	              m_scrollX{0},
+	              m_enteringText{false},
+	              m_mouseSelecting{false},
+	              m_caretClock{},
+	              m_window{nullptr},
+	              m_backgroundView{},
+	              m_scrollView{},
+	              m_scrollbar{nullptr, m_backgroundView, m_scrollView} {
+		m_measureText.setFont(m_font);
+		m_measureText.setCharacterSize(m_charSize);
+
+		m_rectangle.setFillColor(sf::Color(0, 0, 0, 120));
+		m_caret.setFillColor(sf::Color(230, 230, 230));
+		m_caret.setSize({CARET_WIDTH, getLineHeight()});
+
+		m_rectangle.setPosition(_position);
+		setSize(_size);
+		setString(_str);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setPosition(const sf::Vector2f& _position) {
+		m_rectangle.setPosition(_position);
+		setupScrollbar();
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::Vector2f& TextArea::getPosition() const {
+		return m_rectangle.getPosition();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setSize(const sf::Vector2f& _size) {
+		m_rectangle.setSize(_size);
+		m_scrollView.setSize({_size.x - SCROLLBAR_WIDTH, _size.y});
+		m_scrollView.setCenter(m_scrollView.getSize() / 2.F);
+		setupRows();
+		setupScrollbar();
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::Vector2f& TextArea::getSize() const {
+		return m_rectangle.getSize();
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::FloatRect TextArea::getGlobalBounds() const {
+		return m_rectangle.getGlobalBounds();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setColor(const sf::Color& _color) {
+		m_rectangle.setFillColor(_color);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setTextFillColor(const sf::Color& _color) {
+		m_textFillColor = _color;
+		for (auto& row : m_rows) {
+			row.text.setDefaultFillColor(m_textFillColor);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setCaretColor(const sf::Color& _color) {
+		m_caret.setFillColor(_color);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setScrollbarColor(const sf::Color& _color) {
+		m_scrollbar.setColor(_color);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setString(const std::string& _str) {
+		std::basic_string<sf::Uint32> str;
+		sf::Utf8::toUtf32(_str.begin(), _str.end(), std::back_inserter(str));
+
+		m_lines.clear();
+		m_lines.insert(0, Line{});
+		touchLine(0);
+
+		m_caretPos  = {0, 0};
+		m_anchorPos = m_caretPos;
+		m_scrollX   = 0;
+		insert(str);
+
+		moveCaret({0, 0}, false);
+		m_scrollbar.snapToTop();
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::string TextArea::getString() const {
+		std::basic_string<sf::Uint32> str{getText({0, 0}, {m_lines.size() - 1, m_lines[m_lines.size() - 1].text.size()})};
+
+		std::string utf8;
+		utf8.reserve(str.size());
+		sf::Utf32::toUtf8(str.begin(), str.end(), std::back_inserter(utf8));
+		return utf8;
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t TextArea::getLineCount() const {
+		return m_lines.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setActive(bool _b) {
+		m_enteringText = _b;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextArea::enteringText() const {
+		return m_enteringText;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::getInput(sf::Event& _event) {
+		//The scrollbar needs a window to map the mouse position,
+		//which we'll only have once we've been drawn
+		if (m_window != nullptr) {
+			m_scrollbar.getInput(_event, getGlobalBounds());
+		}
+
+		switch (_event.type) {
+		case sf::Event::KeyPressed: {
+			if (m_enteringText) {
+				handleKeyPressed(_event);
+			}
+			break;
+		}
+
+		case sf::Event::TextEntered: {
+			if (m_enteringText) {
+				handleTextEntered(_event.text.unicode);
+			}
+			break;
+		}
+
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+		case sf::Event::MouseMoved: {
+			handleMouseInput(_event);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::update() {
+		m_scrollbar.update();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::draw(sf::RenderWindow& window, sf::RenderStates states) const {
+		m_window         = &window;
+		m_backgroundView = window.getView();
+
+		window.draw(m_rectangle, states);
+
+		const sf::View previousView{window.getView()};
+		window.setView(getContentView(window));
+
+		//Only the lines that intersect the visible content are
+		//bound to rows and drawn
+		float        lineHeight{getLineHeight()};
+		sf::Vector2f offset{getContentOffset()};
+		size_t       first{size_t(std::max(0.F, std::floor(offset.y / lineHeight)))};
+		size_t       last{size_t(std::max(0.F, std::ceil((offset.y + getSize().y) / lineHeight)))};
+		last = std::min({last, first + m_rows.size(), m_lines.size()});
+
+		//Selection highlight
+		m_highlight.clear();
+		const Position& selBegin{getSelectionBegin()};
+		const Position& selEnd{getSelectionEnd()};
+
+		for (size_t i{std::max(first, selBegin.line)}; i < last && i <= selEnd.line && selBegin != selEnd; i++) {
+			float left{i == selBegin.line ? getCharacterPos(selBegin).x : TEXT_PADDING};
+			float right{i == selEnd.line ? getCharacterPos(selEnd).x : getCharacterPos({i, m_lines[i].text.size()}).x + m_charSize / 4.F};
+			float top{i * lineHeight};
+			float bottom{top + lineHeight};
+
+			sf::Color color{250, 250, 250, 100};
+			m_highlight.append({{left, top}, color});
+			m_highlight.append({{right, top}, color});
+			m_highlight.append({{left, bottom}, color});
+			m_highlight.append({{left, bottom}, color});
+			m_highlight.append({{right, top}, color});
+			m_highlight.append({{right, bottom}, color});
+		}
+
+		window.draw(m_highlight, states);
+
+		for (size_t i{first}; i < last; i++) {
+			const Line& line{m_lines[i]};
+			Row&        row{m_rows[i % m_rows.size()]};
+
+			if (row.lineId != line.id) {
+				row.text.setString(sf::String(line.text));
+				row.lineId = line.id;
+			}
+			if (row.index != i) {
+				row.text.setPosition(TEXT_PADDING, i * lineHeight);
+				row.index = i;
+			}
+
+			window.draw(row.text, states);
+		}
+
+		//The caret blinks, but stays visible while it's being moved
+		if (m_enteringText && m_caretClock.getElapsedTime().asMilliseconds() % 1000 < 500) {
+			sf::RectangleShape caret{m_caret};
+			caret.setPosition(getCharacterPos(m_caretPos));
+			window.draw(caret, states);
+		}
+
+		window.setView(previousView);
+		window.draw(m_scrollbar, states);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::handleKeyPressed(sf::Event& _event) {
+		bool     shift{_event.key.shift};
+		Position pos{m_caretPos};
+
+		switch (_event.key.code) {
+		case sf::Keyboard::Left: {
+			if (m_anchorPos != m_caretPos && !shift) {
+				pos = getSelectionBegin();
+			}
+			else if (pos.column > 0) {
+				--pos.column;
+			}
+			else if (pos.line > 0) {
+				--pos.line;
+				pos.column = m_lines[pos.line].text.size();
+			}
+			moveCaret(pos, shift);
+			break;
+		}
+
+		case sf::Keyboard::Right: {
+			if (m_anchorPos != m_caretPos && !shift) {
+				pos = getSelectionEnd();
+			}
+			else if (pos.column < m_lines[pos.line].text.size()) {
+				++pos.column;
+			}
+			else if (pos.line + 1 < m_lines.size()) {
+				++pos.line;
+				pos.column = 0;
+			}
+			moveCaret(pos, shift);
+			break;
+		}
+
+		case sf::Keyboard::Up:
+		case sf::Keyboard::Down:
+		case sf::Keyboard::PageUp:
+		case sf::Keyboard::PageDown: {
+			//Moving vertically keeps the caret as close as possible
+			//to the X position it had before it started moving
+			size_t lines{1};
+			if (_event.key.code == sf::Keyboard::PageUp || _event.key.code == sf::Keyboard::PageDown) {
+				lines = std::max(size_t(1), size_t(getSize().y / getLineHeight()));
+			}
+
+			bool up{_event.key.code == sf::Keyboard::Up || _event.key.code == sf::Keyboard::PageUp};
+			if (up) {
+				pos.line = pos.line > lines ? pos.line - lines : 0;
+			}
+			else {
+				pos.line = std::min(pos.line + lines, m_lines.size() - 1);
+			}
+
+			float preferredX{m_preferredX};
+			moveCaret(getPositionAt({m_preferredX, (pos.line + 0.5F) * getLineHeight()}), shift);
+			m_preferredX = preferredX;
+			break;
+		}
+
+		case sf::Keyboard::Home: {
+			moveCaret({pos.line, 0}, shift);
+			break;
+		}
+
+		case sf::Keyboard::End: {
+			moveCaret({pos.line, m_lines[pos.line].text.size()}, shift);
+			break;
+		}
+
+		case sf::Keyboard::Delete: {
+			if (eraseSelection()) {
+				break;
+			}
+			if (pos.column < m_lines[pos.line].text.size()) {
+				erase(pos, {pos.line, pos.column + 1});
+			}
+			else if (pos.line + 1 < m_lines.size()) {
+				erase(pos, {pos.line + 1, 0});
+			}
+			break;
+		}
+
+		case sf::Keyboard::A: {
+			if (_event.key.control) {
+				m_anchorPos = {0, 0};
+				moveCaret({m_lines.size() - 1, m_lines[m_lines.size() - 1].text.size()}, true);
+			}
+			break;
+		}
+
+		case sf::Keyboard::C:
+		case sf::Keyboard::X: {
+			if (_event.key.control && m_anchorPos != m_caretPos) {
+				sf::Clipboard::setString(sf::String(getText(getSelectionBegin(), getSelectionEnd())));
+				if (_event.key.code == sf::Keyboard::X) {
+					eraseSelection();
+				}
+			}
+			break;
+		}
+
+		case sf::Keyboard::V: {
+			if (_event.key.control) {
+				sf::String                    clipboard{sf::Clipboard::getString()};
+				std::basic_string<sf::Uint32> str;
+				str.reserve(clipboard.getSize());
+
+				//Line breaks and tabs are kept, but other control
+				//characters (including '\r') are dropped
+				for (auto c : clipboard) {
+					if (c == '\n' || c == '\t' || !Util::Unicode::isControl(c)) {
+						str.push_back(c);
+					}
+				}
+
+				insert(str);
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::handleTextEntered(sf::Uint32 _unicode) {
+		//8 = backspace
+		if (_unicode == 8) {
+			if (eraseSelection()) {
+				return;
+			}
+
+			Position pos{m_caretPos};
+			if (pos.column > 0) {
+				erase({pos.line, pos.column - 1}, pos);
+			}
+			else if (pos.line > 0) {
+				erase({pos.line - 1, m_lines[pos.line - 1].text.size()}, pos);
+			}
+		}
+
+		//RETURN enters '\r'
+		else if (_unicode == '\r' || _unicode == '\n') {
+			insert({'\n'});
+		}
+
+		else if (_unicode == '\t' || !Util::Unicode::isControl(_unicode)) {
+			insert({_unicode});
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::handleMouseInput(sf::Event& _event) {
+		if (m_window == nullptr) {
+			return;
+		}
+
+		if (Util::Input::lmbReleased(_event)) {
+			m_mouseSelecting = false;
+			return;
+		}
+
+		sf::Vector2i pixelPos;
+		if (_event.type == sf::Event::MouseMoved && m_mouseSelecting) {
+			pixelPos = {_event.mouseMove.x, _event.mouseMove.y};
+		}
+		else if (Util::Input::lmbPressed(_event)) {
+			pixelPos = {_event.mouseButton.x, _event.mouseButton.y};
+		}
+		else {
+			return;
+		}
+
+		auto mousePos{m_window->mapPixelToCoords(pixelPos, m_backgroundView)};
+		auto contentPos{mousePos - getPosition() + getContentOffset()};
+
+		if (m_mouseSelecting) {
+			moveCaret(getPositionAt(contentPos), true);
+			return;
+		}
+
+		sf::FloatRect textBounds{getPosition(), {getSize().x - SCROLLBAR_WIDTH, getSize().y}};
+
+		if (textBounds.contains(mousePos)) {
+			m_enteringText   = true;
+			m_mouseSelecting = true;
+			moveCaret(getPositionAt(contentPos), InputSnapshot::get_instance().shift());
+		}
+		else if (!getGlobalBounds().contains(mousePos)) {
+			m_enteringText = false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::insert(const std::basic_string<sf::Uint32>& _str) {
+		eraseSelection();
+
+		Position pos{m_caretPos};
+		size_t   lineBreak{_str.find('\n')};
+
+		//Insertions within a single line only touch that line
+		if (lineBreak == std::basic_string<sf::Uint32>::npos) {
+			m_lines[pos.line].text.insert(pos.column, _str);
+			touchLine(pos.line);
+			moveCaret({pos.line, pos.column + _str.size()}, false);
+			return;
+		}
+
+		//Otherwise, the rest of the current line is moved to the
+		//end of the last inserted one
+		std::basic_string<sf::Uint32> tail{m_lines[pos.line].text.substr(pos.column)};
+		m_lines[pos.line].text.erase(pos.column);
+		m_lines[pos.line].text.append(_str, 0, lineBreak);
+		touchLine(pos.line);
+
+		size_t begin{lineBreak + 1};
+		while (true) {
+			size_t end{_str.find('\n', begin)};
+			if (end == std::basic_string<sf::Uint32>::npos) {
+				end = _str.size();
+			}
+
+			Line line;
+			line.text = _str.substr(begin, end - begin);
+			m_lines.insert(++pos.line, line);
+			touchLine(pos.line);
+
+			if (end == _str.size()) {
+				break;
+			}
+			begin = end + 1;
+		}
+
+		pos.column = m_lines[pos.line].text.size();
+		m_lines[pos.line].text += tail;
+
+		setupScrollbar();
+		moveCaret(pos, false);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::erase(const Position& _begin, const Position& _end) {
+		if (_begin.line == _end.line) {
+			m_lines[_begin.line].text.erase(_begin.column, _end.column - _begin.column);
+		}
+		else {
+			Line& first{m_lines[_begin.line]};
+			first.text.erase(_begin.column);
+			first.text.append(m_lines[_end.line].text, _end.column, std::basic_string<sf::Uint32>::npos);
+			m_lines.erase(_begin.line + 1, _end.line - _begin.line);
+			setupScrollbar();
+		}
+
+		touchLine(_begin.line);
+		moveCaret(_begin, false);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextArea::eraseSelection() {
+		if (m_anchorPos == m_caretPos) {
+			return false;
+		}
+
+		Position begin{getSelectionBegin()};
+		Position end{getSelectionEnd()};
+		erase(begin, end);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::basic_string<sf::Uint32> TextArea::getText(const Position& _begin, const Position& _end) const {
+		if (_begin.line == _end.line) {
+			return m_lines[_begin.line].text.substr(_begin.column, _end.column - _begin.column);
+		}
+
+		std::basic_string<sf::Uint32> str{m_lines[_begin.line].text.substr(_begin.column)};
+		for (size_t i{_begin.line + 1}; i < _end.line; i++) {
+			str += '\n';
+			str += m_lines[i].text;
+		}
+		str += '\n';
+		str += m_lines[_end.line].text.substr(0, _end.column);
+
+		return str;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::touchLine(size_t _line) {
+		m_lines[_line].id               = m_nextLineId++;
+		m_lines[_line].layoutNeedUpdate = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<sf::Vector2f>& TextArea::getLineLayout(size_t _line) const {
+		const Line& line{m_lines[_line]};
+
+		if (line.layoutNeedUpdate) {
+			m_measureText.setString(sf::String(line.text));
+			m_measureText.findCharacterPositions(line.positions);
+			line.layoutNeedUpdate = false;
+		}
+
+		return line.positions;
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Vector2f TextArea::getCharacterPos(const Position& _pos) const {
+		const auto& layout{getLineLayout(_pos.line)};
+		size_t      column{std::min(_pos.column, layout.size() - 1)};
+
+		return {TEXT_PADDING + layout[column].x, _pos.line * getLineHeight()};
+	}
+
+	////////////////////////////////////////////////////////////
+	TextArea::Position TextArea::getPositionAt(const sf::Vector2f& _point) const {
+		float  line{std::floor(_point.y / getLineHeight())};
+		size_t lineIndex{line < 0 ? 0 : std::min(size_t(line), m_lines.size() - 1)};
+
+		const auto& layout{getLineLayout(lineIndex)};
+		float       x{_point.x - TEXT_PADDING};
+
+		auto comparePos{[](const sf::Vector2f& _pos, float _x) {
+			return _pos.x < _x;
+		}};
+
+		auto   it{std::lower_bound(layout.begin(), layout.end(), x, comparePos)};
+		size_t column(it - layout.begin());
+
+		//We'll pick whichever of the two surrounding positions is
+		//closest to the point
+		if (column == layout.size() ||
+		    (column > 0 && x - layout[column - 1].x < layout[column].x - x)) {
+			--column;
+		}
+
+		return {lineIndex, column};
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::moveCaret(const Position& _pos, bool _select) {
+		m_caretPos = _pos;
+		if (!_select) {
+			m_anchorPos = _pos;
+		}
+
+		m_preferredX = getCharacterPos(m_caretPos).x;
+		m_caretClock.restart();
+		scrollToCaret();
+	}
+
+	////////////////////////////////////////////////////////////
+	const TextArea::Position& TextArea::getSelectionBegin() const {
+		return m_anchorPos < m_caretPos ? m_anchorPos : m_caretPos;
+	}
+
+	////////////////////////////////////////////////////////////
+	const TextArea::Position& TextArea::getSelectionEnd() const {
+		return m_anchorPos < m_caretPos ? m_caretPos : m_anchorPos;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::scrollToCaret() {
+		sf::Vector2f caretPos{getCharacterPos(m_caretPos)};
+		sf::Vector2f offset{getContentOffset()};
+		sf::Vector2f visibleSize{m_scrollView.getSize()};
+		float        lineHeight{getLineHeight()};
+
+		if (caretPos.y < offset.y) {
+			m_scrollbar.scrollTo(caretPos.y + visibleSize.y / 2);
+		}
+		else if (caretPos.y + lineHeight > offset.y + visibleSize.y) {
+			m_scrollbar.scrollTo(caretPos.y + lineHeight - visibleSize.y / 2);
+		}
+
+		//Long lines are scrolled horizontally, a quarter of the
+		//width at a time
+		if (caretPos.x < m_scrollX + TEXT_PADDING) {
+			m_scrollX = std::max(0.F, caretPos.x - visibleSize.x / 4);
+		}
+		else if (caretPos.x + CARET_WIDTH > m_scrollX + visibleSize.x) {
+			m_scrollX = caretPos.x + CARET_WIDTH - visibleSize.x * 3 / 4;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setupScrollbar() {
+		float visibleHeight{getSize().y};
+		float contentHeight{m_lines.size() * getLineHeight()};
+
+		float minRange{visibleHeight / 2};
+		float maxRange{std::max(minRange, contentHeight - visibleHeight / 2)};
+
+		sf::Vector2f scrollbarSize{SCROLLBAR_WIDTH, visibleHeight};
+		sf::Vector2f scrollbarPosition{getPosition().x + getSize().x - SCROLLBAR_WIDTH,
+		                               getPosition().y};
+
+		m_scrollbar.setActive(contentHeight > visibleHeight);
+		m_scrollbar.reset(scrollbarSize, scrollbarPosition, minRange, maxRange);
+
+		//An inactive scrollbar doesn't move the view, so we'll make
+		//sure the content isn't left scrolled past its end
+		if (contentHeight <= visibleHeight) {
+			m_scrollView.setCenter(m_scrollView.getCenter().x, minRange);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextArea::setupRows() {
+		//One extra row covers a partially visible line at both
+		//the top and the bottom
+		size_t rowCount{size_t(std::ceil(getSize().y / getLineHeight())) + 1};
+
+		m_rows.resize(std::max(rowCount, size_t(1)));
+		for (auto& row : m_rows) {
+			row.text.setFont(m_font);
+			row.text.setCharacterSize(m_charSize);
+			row.text.setDefaultFillColor(m_textFillColor);
+			row.lineId = 0;
+			row.index  = NO_LINE;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	float TextArea::getLineHeight() const {
+		return m_font.getLineSpacing(m_charSize);
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Vector2f TextArea::getContentOffset() const {
+		return {m_scrollX, m_scrollView.getCenter().y - m_scrollView.getSize().y / 2};
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::View TextArea::getContentView(const sf::RenderTarget& _target) const {
+		sf::FloatRect bounds{getPosition(), m_scrollView.getSize()};
+
+		sf::View contentView{sf::FloatRect{getContentOffset(), m_scrollView.getSize()}};
+		contentView.setViewport(Util::Coordinates::getViewportCovering(_target.getView(), bounds));
+		return contentView;
+	}
+
+} //namespace spss
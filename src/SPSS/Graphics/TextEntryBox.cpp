@@ -1,4 +1,8 @@
 #include <SPSS/Graphics/TextEntryBox.h>
+#include <SPSS/System/InputSnapshot.h>
+#include <SPSS/Util/Coordinates.h>
+#include <SPSS/Util/Input.h>
+#include <SPSS/Util/Unicode.h>
 
 #include <iostream>
 
@@ -12,21 +16,23 @@ constexpr sf::Keyboard::Key TEXT_MOVERIGHT   = sf::Keyboard::Right;
 constexpr sf::Keyboard::Key TEXT_COPY        = sf::Keyboard::C;
 constexpr sf::Keyboard::Key TEXT_CUT         = sf::Keyboard::X;
 constexpr sf::Keyboard::Key TEXT_PASTE       = sf::Keyboard::V;
+constexpr sf::Keyboard::Key TEXT_UNDO        = sf::Keyboard::Z;
+constexpr sf::Keyboard::Key TEXT_REDO        = sf::Keyboard::Y;
 constexpr sf::Keyboard::Key TEXT_RETURN      = sf::Keyboard::Return;
+constexpr sf::Keyboard::Key TEXT_COMPLETE    = sf::Keyboard::Tab;
+constexpr sf::Keyboard::Key SUGGESTION_PREV  = sf::Keyboard::Up;
+constexpr sf::Keyboard::Key SUGGESTION_NEXT  = sf::Keyboard::Down;
+constexpr sf::Int32         DOUBLECLICK_TIME = 500;
+constexpr float             SUGGESTION_PAD   = 4.F;
+constexpr float             CARET_FADE_TIME  = 800.F;
+constexpr unsigned int      MAX_CHARS        = 1 << 14;
 
 const bool keyPressed(sf::Keyboard::Key _key) {
-	return sf::Keyboard::isKeyPressed(_key);
+	return spss::InputSnapshot::get_instance().isKeyPressed(_key);
 }
 
-const bool keysPressedTogether(const std::vector<sf::Keyboard::Key>& _keys) {
-	bool allPressed{true};
-	for (const auto& key : _keys) {
-		if (!keyPressed(key)) {
-			allPressed = false;
-			break;
-		}
-	}
-	return allPressed;
+const bool keysPressedTogether(std::initializer_list<sf::Keyboard::Key> _keys) {
+	return spss::InputSnapshot::get_instance().areKeysPressed(_keys);
 }
 
 namespace spss {
@@ -38,6 +44,8 @@ namespace spss {
 	                           const unsigned int  _charSize,
 	                           const std::string&  _str)
 	            : m_font{_font},
+	              m_buffer{},
+	              m_wordIndex{},
 	              m_rectangle(),
 	              m_selectionBegin(0),
 	              m_selectionEnd(0),
@@ -49,21 +57,49 @@ namespace spss {
 	              m_alwaysActive{false},
 	              m_lastString{},
 	              m_charSize{_charSize},
-	              m_maxChars{255},
+	              m_maxChars{MAX_CHARS},
 	              m_textFillColor{sf::Color::White},
 	              m_textOutlineColor{sf::Color::Black},
 	              m_textOutlineThickness{0},
-	              m_alphaUpdateNeeded{false},
-	              m_xOffset{0.F} {
+	              m_xOffset{0.F},
+	              m_charPositions{},
+	              m_charPositionsNeedUpdate{true},
+	              m_charPositionsStart{0},
+	              m_target{nullptr},
+	              m_clipView{},
+	              m_mouseSelecting{false},
+	              m_mouseAnchor{0},
+	              m_lastClickPos{0},
+	              m_clickClock{},
+	              m_caretBlink{spss::Animator::get_instance().tween(255.F, 0.F, CARET_FADE_TIME,
+	                                                               spss::Animator::Easing::Linear,
+	                                                               spss::Animator::Repeat::PingPong)},
+	              m_completionProvider{nullptr},
+	              m_maxSuggestions{0},
+	              m_suggestions{},
+	              m_suggestionTexts{},
+	              m_suggestionBox{},
+	              m_suggestionHighlight{},
+	              m_selectedSuggestion{0},
+	              m_completionStart{0},
+	              m_completionEnd{0},
+	              m_suggestionsNeedUpdate{false} {
 		setWidth(_width);
 		setPosition(_position);
 		setCharSize(m_charSize);
-		setTextString(_str);
+		setTextString(sf::String::fromUtf8(_str.begin(), _str.end()));
 
 		m_rectangle.setFillColor(sf::Color(0, 0, 0, 120));
 		m_highlightedRectangle.setFillColor(sf::Color(250, 250, 250, 100));
+		m_suggestionBox.setFillColor(sf::Color(0, 0, 0, 200));
+		m_suggestionHighlight.setFillColor(sf::Color(250, 250, 250, 100));
 
 		m_text.setFont(m_font);
+		m_charPositionsNeedUpdate = true;
+		m_charPositionsStart      = 0;
+		m_text.setDefaultFillColor(m_textFillColor);
+		m_text.setDefaultOutlineColor(m_textOutlineColor);
+		m_text.setDefaultOutlineThickness(m_textOutlineThickness);
 		m_caret.setFont(m_font);
 		m_caret.setFillColor(sf::Color(230, 230, 230));
 		m_caret.setString("I");
@@ -85,6 +121,7 @@ namespace spss {
 		                     _position.y};
 
 		setTextPosition(textPos);
+		m_suggestionsNeedUpdate = true;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -109,18 +146,20 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::setTextFillColor(const sf::Color& _c) {
-		m_textFillColor     = _c;
-		m_alphaUpdateNeeded = true;
+		m_textFillColor = _c;
+		m_text.setDefaultFillColor(m_textFillColor);
 	}
 
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::setTextOutlineColor(const sf::Color& _c) {
 		m_textOutlineColor = _c;
+		m_text.setDefaultOutlineColor(m_textOutlineColor);
 	}
 
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::setTextOutlineThickness(float _f) {
 		m_textOutlineThickness = _f;
+		m_text.setDefaultOutlineThickness(m_textOutlineThickness);
 	}
 
 	////////////////////////////////////////////////////////////
@@ -163,6 +202,8 @@ namespace spss {
 		m_charSize = _i;
 		m_text.setCharacterSize(m_charSize);
 		m_caret.setCharacterSize(m_charSize);
+		m_charPositionsNeedUpdate = true;
+		m_charPositionsStart      = 0;
 		setWidth(getWidth());
 	}
 
@@ -181,21 +222,34 @@ namespace spss {
 		m_alwaysActive = _b;
 	}
 
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::setUndoMemoryCap(size_t _bytes) {
+		m_history.setMemoryCap(_bytes);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::setCompletionProvider(const spss::CompletionProvider* _provider,
+	                                         size_t                          _maxSuggestions) {
+		m_completionProvider    = _provider;
+		m_maxSuggestions        = _maxSuggestions;
+		m_suggestionsNeedUpdate = true;
+		clearSuggestions();
+	}
+
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::setWidth(float _width) {
 		float oldWidth{m_rectangle.getSize().x};
 		m_rectangle.setSize({_width, float(1.25 * getLineSpacing())});
 
 		//If our new size is smaller, we'll shift the text to the left
-		//if needed and update transparency if so. We'll also update
-		//the transparency if the text is wider than the box.
+		//if needed
 		if (_width < oldWidth) {
-			m_alphaUpdateNeeded = shiftTextToLeft() || textTooWide();
+			shiftTextToLeft();
 		}
 
 		//Similar logic applies if the new width is greater
 		else if (_width > oldWidth) {
-			m_alphaUpdateNeeded = shiftTextToRight() || textTooWide();
+			shiftTextToRight();
 		}
 	}
 
@@ -236,22 +290,39 @@ namespace spss {
 			if (_event.key.code == TEXT_RETURN) {
 				if (m_enteringText && !stringEmpty()) {
 					m_inputComplete = true;
-					m_lastString    = m_text.getString();
+					m_lastString    = getCurrentString();
 					if (!m_alwaysActive) {
 						clearText();
 					}
 				}
 			}
 
+			else if (!m_suggestions.empty() && _event.key.code == TEXT_COMPLETE) {
+				acceptSuggestion();
+			}
+
+			else if (!m_suggestions.empty() && _event.key.code == SUGGESTION_PREV) {
+				m_selectedSuggestion = (m_selectedSuggestion + m_suggestions.size() - 1) % m_suggestions.size();
+				m_suggestionHighlight.setPosition(m_suggestionTexts[m_selectedSuggestion].getPosition());
+			}
+
+			else if (!m_suggestions.empty() && _event.key.code == SUGGESTION_NEXT) {
+				m_selectedSuggestion = (m_selectedSuggestion + 1) % m_suggestions.size();
+				m_suggestionHighlight.setPosition(m_suggestionTexts[m_selectedSuggestion].getPosition());
+			}
+
 			else if (keysPressedTogether({LSHIFT, TEXT_SELECTLEFT})) {
+				m_history.seal();
 				selectLeft();
 			}
 
 			else if (keysPressedTogether({LSHIFT, TEXT_SELECTRIGHT})) {
+				m_history.seal();
 				selectRight();
 			}
 
 			else if (keysPressedTogether({LCTRL, TEXT_SELECTALL})) {
+				m_history.seal();
 				selectAll();
 			}
 
@@ -270,15 +341,25 @@ namespace spss {
 				if (sequenceSelected()) {
 					deleteSelection();
 				}
-				std::string s{sf::Clipboard::getString()};
-				insert(s);
+				insert(sf::Clipboard::getString());
+			}
+
+			else if (keysPressedTogether({LCTRL, LSHIFT, TEXT_UNDO}) ||
+			         keysPressedTogether({LCTRL, TEXT_REDO})) {
+				redo();
+			}
+
+			else if (keysPressedTogether({LCTRL, TEXT_UNDO})) {
+				undo();
 			}
 
 			else if (keyPressed(TEXT_MOVELEFT)) {
+				m_history.seal();
 				moveLeft();
 			}
 
 			else if (keyPressed(TEXT_MOVERIGHT)) {
+				m_history.seal();
 				moveRight();
 			}
 
@@ -293,6 +374,13 @@ namespace spss {
 			break;
 		}
 
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+		case sf::Event::MouseMoved: {
+			handleMouseInput(_event);
+			break;
+		}
+
 		default:
 			break;
 		}
@@ -306,22 +394,45 @@ namespace spss {
 		if (m_enteringText) {
 			updateHighlight();
 			updateCaret();
+
+			//Suggestions are only looked up again once the text has
+			//been edited or the caret has moved
+			if (m_completionProvider != nullptr &&
+			    (m_suggestionsNeedUpdate || m_selectionBegin != m_completionEnd ||
+			     (sequenceSelected() && !m_suggestions.empty()))) {
+				updateSuggestions();
+			}
 		}
 	}
 
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::draw(sf::RenderTarget& target,
 	                        sf::RenderStates  states) const {
-		updateAlpha();
+		m_target = &target;
 
 		if (m_enteringText || m_alwaysVisible) {
 			target.draw(m_rectangle, states);
+
+			//Anything that overflows out of the box is clipped by
+			//drawing through a view that only covers the box
+			const sf::View previousView{target.getView()};
+			m_clipView = getClippingView(target, states);
+			target.setView(m_clipView);
 			target.draw(m_text, states);
 			target.draw(m_highlightedRectangle, states);
+			target.setView(previousView);
 		}
 
 		if (m_enteringText) {
 			target.draw(m_caret, states);
+
+			if (!m_suggestions.empty()) {
+				target.draw(m_suggestionBox, states);
+				target.draw(m_suggestionHighlight, states);
+				for (const auto& text : m_suggestionTexts) {
+					target.draw(text, states);
+				}
+			}
 		}
 	}
 
@@ -344,9 +455,22 @@ namespace spss {
 		return m_lastString;
 	}
 
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::clear() {
+		clearText();
+		clearSuggestions();
+		m_lastString.clear();
+		m_inputComplete = false;
+	}
+
 	////////////////////////////////////////////////////////////
 	const std::string TextEntryBox::getCurrentString() const {
-		return m_text.getString();
+		const sf::String& str{m_text.getString()};
+
+		std::string utf8;
+		utf8.reserve(str.getSize());
+		sf::Utf32::toUtf8(str.begin(), str.end(), std::back_inserter(utf8));
+		return utf8;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -354,6 +478,20 @@ namespace spss {
 		m_enteringText = _b;
 	}
 
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::undo() {
+		if (auto edit{m_history.undo()}) {
+			applyEdit(edit->pos, edit->inserted.size(), edit->removed);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::redo() {
+		if (auto edit{m_history.redo()}) {
+			applyEdit(edit->pos, edit->removed.size(), edit->inserted);
+		}
+	}
+
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::handleInput(sf::Uint32 _unicode) {
 		//Since typing "A" counts as text entry, we'll see if
@@ -375,7 +513,7 @@ namespace spss {
 				deleteSelection();
 			}
 
-			insert(static_cast<char>(_unicode));
+			insert(_unicode);
 		}
 	}
 
@@ -388,39 +526,31 @@ namespace spss {
 	}
 
 	////////////////////////////////////////////////////////////
-	void TextEntryBox::setTextString(const std::string& _str) {
-		m_text.setString(_str);
-		m_text.setOutlineThickness(m_textOutlineThickness);
-		updateCaret();
+	void TextEntryBox::setTextString(const sf::String& _str) {
+		m_buffer.assign(_str.begin(), _str.end());
+		m_wordIndex.clear();
+		m_wordIndex.insert(0, _str.begin(), _str.end());
+		m_history.clear();
+		updateTextString(0, m_text.getString().getSize(), _str);
 	}
 
 	////////////////////////////////////////////////////////////
-	void TextEntryBox::updateAlpha() const {
-		if (!m_alphaUpdateNeeded) {
-			return;
-		}
-
-		m_alphaUpdateNeeded = false;
-
-		auto        rectBounds{m_rectangle.getGlobalBounds()};
-		std::string textStr{m_text.getString()};
-
-		for (size_t i{0}; i < textStr.length(); i++) {
-			auto pos{m_text.findCharacterPos(i)};
-			char charAtPos{textStr.at(i)};
-			auto glyph{m_font.getGlyph(charAtPos, m_charSize, false, m_text.getOutlineThickness(i))};
-			auto charWidth{glyph.bounds.width};
-			auto fillColor{m_textFillColor};
-			auto outlineColor{m_textOutlineColor};
+	void TextEntryBox::updateTextString(size_t _pos, size_t _count, const sf::String& _insert) {
+		m_text.replace(_pos, _count, _insert);
+		m_charPositionsNeedUpdate = true;
+		m_charPositionsStart      = std::min(m_charPositionsStart, _pos);
+		m_suggestionsNeedUpdate   = true;
+		updateCaret();
+	}
 
-			if (pos.x < rectBounds.left || (pos.x + charWidth) > (rectBounds.left + rectBounds.width)) {
-				fillColor    = sf::Color::Transparent;
-				outlineColor = sf::Color::Transparent;
-			}
+	////////////////////////////////////////////////////////////
+	sf::View TextEntryBox::getClippingView(const sf::RenderTarget& _target,
+	                                       const sf::RenderStates& _states) const {
+		auto bounds{_states.transform.transformRect(m_rectangle.getGlobalBounds())};
 
-			m_text.setFillColor(fillColor, i, i);
-			m_text.setOutlineColor(outlineColor, i, i);
-		}
+		sf::View clipView{bounds};
+		clipView.setViewport(Util::Coordinates::getViewportCovering(_target.getView(), bounds));
+		return clipView;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -434,18 +564,17 @@ namespace spss {
 				selectionToUse = m_selectionEnd;
 			}
 
-			caretPos = m_text.findCharacterPos(selectionToUse);
+			caretPos = getCharacterPos(selectionToUse);
 
 			if (selectionToUse > 0) {
 				//We'll position the caret as accurately as possible,
 				//by positioning it exactly between the current and
 				//previous characters
-				size_t      prevPos{selectionToUse - 1};
-				std::string textStr{m_text.getString()};
-				char        charAtPrevPos{textStr.at(prevPos)};
-				auto        prevGlyph{m_font.getGlyph(charAtPrevPos, m_charSize, false, m_text.getOutlineThickness(prevPos))};
-				auto        prevCharPos{m_text.findCharacterPos(prevPos)};
-				auto        prevCharWidth{prevGlyph.bounds.width};
+				size_t     prevPos{selectionToUse - 1};
+				sf::Uint32 charAtPrevPos{m_buffer[prevPos]};
+				auto       prevGlyph{m_font.getGlyph(charAtPrevPos, m_charSize, false, m_text.getOutlineThickness(prevPos))};
+				auto       prevCharPos{getCharacterPos(prevPos)};
+				auto       prevCharWidth{prevGlyph.bounds.width};
 				prevCharPos.x += prevCharWidth;
 				caretPos.x = prevCharPos.x + ((caretPos.x - prevCharPos.x) / 2);
 			}
@@ -454,24 +583,8 @@ namespace spss {
 		m_caret.setPosition(caretPos);
 
 		if (m_enteringText) {
-			static bool      caretAlphaDecreasing{true};
-			static sf::Uint8 caretAlphaValue{255};
-
-			if (caretAlphaDecreasing) {
-				caretAlphaValue -= 5;
-				if (caretAlphaValue <= 0) {
-					caretAlphaDecreasing = false;
-				}
-			}
-			else {
-				caretAlphaValue += 5;
-				if (caretAlphaValue >= 255) {
-					caretAlphaDecreasing = true;
-				}
-			}
-
 			sf::Color caretColor = m_caret.getFillColor();
-			caretColor.a         = caretAlphaValue;
+			caretColor.a         = sf::Uint8(m_caretBlink.getFloat());
 			m_caret.setFillColor(caretColor);
 		}
 	}
@@ -479,8 +592,8 @@ namespace spss {
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::updateHighlight() {
 		if (sequenceSelected()) {
-			auto startPos{m_text.findCharacterPos(m_selectionBegin)};
-			auto endPos{m_text.findCharacterPos(m_selectionEnd)};
+			auto startPos{getCharacterPos(m_selectionBegin)};
+			auto endPos{getCharacterPos(m_selectionEnd)};
 
 			float maxStartX{m_rectangle.getPosition().x};
 			float maxEndX{m_rectangle.getPosition().x + m_rectangle.getLocalBounds().width};
@@ -504,16 +617,16 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	bool TextEntryBox::stringEmpty() const {
-		return m_text.getString().isEmpty();
+		return m_buffer.empty();
 	}
 
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::selectAll() {
 		m_selectionBegin     = 0;
-		m_selectionEnd       = m_text.getString().getSize();
+		m_selectionEnd       = m_buffer.size();
 		m_selectionDirection = SELDIR::NEUTRAL;
 		updateCaret();
-		m_alphaUpdateNeeded = (shiftTextToRight() || textTooWide());
+		shiftTextToRight();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -549,7 +662,7 @@ namespace spss {
 		}
 
 		updateCaret();
-		m_alphaUpdateNeeded = shiftTextToRight();
+		shiftTextToRight();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -578,7 +691,7 @@ namespace spss {
 		}
 
 		updateCaret();
-		m_alphaUpdateNeeded = shiftTextToLeft();
+		shiftTextToLeft();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -640,6 +753,128 @@ namespace spss {
 		return false;
 	}
 
+	////////////////////////////////////////////////////////////
+	sf::Vector2f TextEntryBox::getCharacterPos(size_t _index) const {
+		if (m_charPositionsNeedUpdate) {
+			m_text.findCharacterPositions(m_charPositions, m_charPositionsStart);
+			m_charPositionsNeedUpdate = false;
+			m_charPositionsStart      = m_charPositions.size();
+		}
+
+		_index = std::min(_index, m_charPositions.size() - 1);
+		return m_text.getTransform().transformPoint(m_charPositions[_index]);
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t TextEntryBox::getCharacterAt(const sf::Vector2f& _point) const {
+		//Make sure the table is up to date
+		getCharacterPos(0);
+
+		float x{m_text.getInverseTransform().transformPoint(_point).x};
+
+		auto comparePos{[](const sf::Vector2f& _pos, float _x) {
+			return _pos.x < _x;
+		}};
+
+		auto   it{std::lower_bound(m_charPositions.begin(), m_charPositions.end(), x, comparePos)};
+		size_t pos(it - m_charPositions.begin());
+
+		//We'll pick whichever of the two surrounding positions is
+		//closest to the point
+		if (pos == m_charPositions.size() ||
+		    (pos > 0 && x - m_charPositions[pos - 1].x < m_charPositions[pos].x - x)) {
+			--pos;
+		}
+
+		return pos;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::handleMouseInput(sf::Event& _event) {
+		if (m_target == nullptr || !(m_enteringText || m_alwaysVisible)) {
+			return;
+		}
+
+		if (Util::Input::lmbReleased(_event)) {
+			m_mouseSelecting = false;
+			return;
+		}
+
+		sf::Vector2i pixelPos;
+		if (_event.type == sf::Event::MouseMoved) {
+			if (!m_mouseSelecting) {
+				return;
+			}
+			pixelPos = {_event.mouseMove.x, _event.mouseMove.y};
+		}
+		else if (Util::Input::lmbPressed(_event)) {
+			pixelPos = {_event.mouseButton.x, _event.mouseButton.y};
+		}
+		else {
+			return;
+		}
+
+		//The clip view maps the text to the same place as the view
+		//the box was drawn with, whatever the target's view is now
+		auto mousePos{m_target->mapPixelToCoords(pixelPos, m_clipView)};
+		auto pos{getCharacterAt(mousePos)};
+
+		if (m_mouseSelecting) {
+			selectRange(m_mouseAnchor, pos);
+			return;
+		}
+
+		if (!m_rectangle.getGlobalBounds().contains(mousePos)) {
+			return;
+		}
+
+		m_enteringText = true;
+		m_history.seal();
+
+		auto sinceLast{m_clickClock.restart()};
+		bool doubleClick{pos == m_lastClickPos && sinceLast < sf::milliseconds(DOUBLECLICK_TIME)};
+		m_lastClickPos = pos;
+
+		if (doubleClick) {
+			selectWordAt(pos);
+			return;
+		}
+
+		m_mouseSelecting = true;
+		m_mouseAnchor    = pos;
+		selectRange(m_mouseAnchor, pos);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::selectRange(size_t _anchor, size_t _pos) {
+		m_selectionBegin     = std::min(_anchor, _pos);
+		m_selectionEnd       = std::max(_anchor, _pos);
+		m_selectionDirection = _pos < _anchor ? SELDIR::LEFT : SELDIR::RIGHT;
+
+		updateCaret();
+		updateHighlight();
+
+		//The caret may have been dragged past either edge
+		if (!shiftTextToRight()) {
+			shiftTextToLeft();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::selectWordAt(size_t _pos) {
+		size_t begin{_pos};
+		size_t end{_pos};
+
+		if (begin > 0 && m_buffer[begin - 1] != ' ') {
+			begin = posAtPreviousWord(begin);
+		}
+		if (end < m_buffer.size() && m_buffer[end] != ' ') {
+			end = posAtNextWord(end);
+		}
+
+		selectRange(begin, end);
+	}
+
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::resetTextPosition() {
 		auto textPos{m_text.getPosition()};
@@ -647,7 +882,7 @@ namespace spss {
 		m_xOffset = 0.F;
 		setTextPosition(textPos);
 
-		m_alphaUpdateNeeded = shiftTextToLeft();
+		shiftTextToLeft();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -663,7 +898,7 @@ namespace spss {
 		m_selectionDirection = SELDIR::NEUTRAL;
 
 		updateCaret();
-		m_alphaUpdateNeeded = (shiftTextToRight() || textTooWide());
+		shiftTextToRight();
 	}
 
 	////////////////////////////////////////////////////////////
@@ -678,7 +913,7 @@ namespace spss {
 		else if (sequenceSelected()) {
 			m_selectionBegin = m_selectionEnd;
 		}
-		else if (m_selectionBegin < m_text.getString().getSize()) {
+		else if (m_selectionBegin < m_buffer.size()) {
 			moveSelectionBegin(1);
 			m_selectionEnd = m_selectionBegin;
 		}
@@ -686,52 +921,17 @@ namespace spss {
 		m_selectionDirection = SELDIR::NEUTRAL;
 
 		updateCaret();
-
-		m_alphaUpdateNeeded = (shiftTextToLeft() || textTooWide());
+		shiftTextToLeft();
 	}
 
 	////////////////////////////////////////////////////////////
 	size_t TextEntryBox::posAtPreviousWord(size_t _from) const {
-		size_t pos{_from};
-		if (pos == 0) {
-			return pos;
-		}
-
-		std::string s{m_text.getString()};
-		std::string previousChar{s.substr(pos - 1, 1)};
-		if (previousChar == " ") {
-			while (pos > 0 && s.substr(pos - 1, 1) == " ") {
-				--pos;
-			}
-		}
-
-		while (pos > 0 && s.substr(pos - 1, 1) != " ") {
-			--pos;
-		}
-
-		return pos;
+		return m_wordIndex.previousWord(_from);
 	}
 
 	////////////////////////////////////////////////////////////
 	size_t TextEntryBox::posAtNextWord(size_t _from) const {
-		size_t      pos{_from};
-		std::string s{m_text.getString()};
-		if (pos == s.length()) {
-			return pos;
-		}
-
-		std::string previousChar{s.substr(pos, 1)};
-		if (previousChar == " ") {
-			while (pos < s.length() && s.substr(pos, 1) == " ") {
-				++pos;
-			}
-		}
-
-		while (pos < s.length() && s.substr(pos, 1) != " ") {
-			++pos;
-		}
-
-		return pos;
+		return m_wordIndex.nextWord(_from);
 	}
 
 	////////////////////////////////////////////////////////////
@@ -745,36 +945,39 @@ namespace spss {
 			return;
 		}
 
-		std::string newString{m_text.getString()};
-
-		if (sequenceSelected()) {
-			newString.erase(m_selectionBegin, m_selectionEnd - m_selectionBegin);
-		}
-		else {
+		if (!sequenceSelected()) {
 			selectLeft();
-			newString.erase(m_selectionBegin, 1);
 		}
 
+		size_t count{m_selectionEnd - m_selectionBegin};
+
+		std::basic_string<sf::Uint32> removed;
+		m_buffer.copy(m_selectionBegin, count, std::back_inserter(removed));
+		m_history.record(m_selectionBegin, std::move(removed), {});
+
+		m_buffer.erase(m_selectionBegin, count);
+		m_wordIndex.erase(m_selectionBegin, count);
+
 		m_selectionEnd       = m_selectionBegin;
 		m_selectionDirection = SELDIR::NEUTRAL;
-		setTextString(newString);
+		updateTextString(m_selectionBegin, count, {});
 
 		updateCaret();
 		shiftTextToRight();
-
-		m_alphaUpdateNeeded = (textTooWide());
 	}
 
 	////////////////////////////////////////////////////////////
-	const std::string TextEntryBox::getSelection() const {
-		std::string s{m_text.getString()};
-		return s.substr(m_selectionBegin, m_selectionEnd);
+	const sf::String TextEntryBox::getSelection() const {
+		std::basic_string<sf::Uint32> selection;
+		m_buffer.copy(m_selectionBegin,
+		              m_selectionEnd - m_selectionBegin,
+		              std::back_inserter(selection));
+		return sf::String(selection);
 	}
 
 	////////////////////////////////////////////////////////////
 	bool TextEntryBox::validInsertion(sf::Uint32 _unicode) const {
-		if (_unicode >= 32 && _unicode <= 255 &&
-		    m_text.getString().getSize() < m_maxChars) {
+		if (!Util::Unicode::isControl(_unicode) && m_buffer.size() < m_maxChars) {
 			return true;
 		}
 
@@ -782,55 +985,58 @@ namespace spss {
 	}
 
 	////////////////////////////////////////////////////////////
-	void TextEntryBox::insert(std::string& _str) {
-		_str.erase(std::remove_if(_str.begin(),
-		                          _str.end(),
-		                          [](char c) {
-			                          return (c == '\n' || c == '\t' || c == '\r');
-		                          }),
-		           _str.end());
+	void TextEntryBox::insert(const sf::String& _str) {
+		size_t available{m_maxChars > m_buffer.size() ? m_maxChars - m_buffer.size() : 0};
 
-		if (_str.empty()) {
-			return;
-		}
+		//Filter and truncate the string in a single pass, so that
+		//nothing past what can actually be inserted is looked at
+		std::basic_string<sf::Uint32> str;
+		str.reserve(std::min(size_t(_str.getSize()), available));
 
-		size_t currentLength{m_text.getString().getSize()};
-		size_t combinedLength{_str.length() + currentLength};
+		for (auto it{_str.begin()}; it != _str.end() && str.size() < available; ++it) {
+			if (!Util::Unicode::isControl(*it)) {
+				str.push_back(*it);
+			}
+		}
 
-		if (combinedLength > m_maxChars) {
-			_str = _str.substr(0, m_maxChars - currentLength);
+		if (str.empty()) {
+			return;
 		}
 
-		std::string newString{m_text.getString()};
-		newString.insert(m_selectionBegin, _str);
+		size_t pos{m_selectionBegin};
 
-		setTextString(newString);
-		//In some cases, like after selecting all and inputting
-		//a character, our caret will be too far off to the left.
-		//
-		//shiftTextToRight() will take care of that if so, and
-		//do nothing if not.
-		shiftTextToRight();
+		m_buffer.insert(pos, str.begin(), str.end());
+		m_wordIndex.insert(pos, str.begin(), str.end());
+		m_history.record(pos, {}, str);
 
-		m_selectionEnd       = m_selectionBegin + _str.length() - 1;
-		m_selectionBegin     = m_selectionEnd;
+		m_selectionBegin += str.size();
+
+		m_selectionEnd       = m_selectionBegin;
 		m_selectionDirection = SELDIR::NEUTRAL;
 
-		moveRight();
+		updateTextString(pos, 0, str);
+
+		//The caret may have ended up on either side of the box,
+		//for example after selecting all and pasting a short
+		//string, or after pasting a long one
+		if (!shiftTextToRight()) {
+			shiftTextToLeft();
+		}
 	}
 
 	////////////////////////////////////////////////////////////
-	void TextEntryBox::insert(char _char) {
-		size_t newLength{m_text.getString().getSize() + 1};
+	void TextEntryBox::insert(sf::Uint32 _unicode) {
+		size_t newLength{m_buffer.size() + 1};
 
 		if (newLength > m_maxChars) {
 			return;
 		}
 
-		std::string newString{m_text.getString()};
-		newString.insert(m_selectionBegin, {_char});
+		m_buffer.insert(m_selectionBegin, _unicode);
+		m_wordIndex.insert(m_selectionBegin, _unicode == ' ');
+		m_history.record(m_selectionBegin, {}, std::basic_string<sf::Uint32>(1, _unicode));
 
-		setTextString(newString);
+		updateTextString(m_selectionBegin, 0, _unicode);
 		//In some cases, like after selecting all and inputting
 		//a character, our caret will be too far off to the left.
 		//
@@ -853,6 +1059,26 @@ namespace spss {
 		resetTextPosition();
 	}
 
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::applyEdit(size_t                               _pos,
+	                             size_t                               _count,
+	                             const std::basic_string<sf::Uint32>& _insert) {
+		m_buffer.erase(_pos, _count);
+		m_wordIndex.erase(_pos, _count);
+		m_buffer.insert(_pos, _insert.begin(), _insert.end());
+		m_wordIndex.insert(_pos, _insert.begin(), _insert.end());
+
+		m_selectionBegin     = _pos + _insert.size();
+		m_selectionEnd       = m_selectionBegin;
+		m_selectionDirection = SELDIR::NEUTRAL;
+
+		updateTextString(_pos, _count, _insert);
+
+		if (!shiftTextToRight()) {
+			shiftTextToLeft();
+		}
+	}
+
 	////////////////////////////////////////////////////////////
 	void TextEntryBox::moveSelectionBegin(int _a) {
 		int d{int(m_selectionBegin) + _a};
@@ -860,8 +1086,8 @@ namespace spss {
 			m_selectionBegin = 0;
 			return;
 		}
-		else if (d > m_text.getString().getSize()) {
-			m_selectionBegin = m_text.getString().getSize();
+		else if (d > m_buffer.size()) {
+			m_selectionBegin = m_buffer.size();
 			return;
 		}
 		m_selectionBegin += _a;
@@ -874,8 +1100,8 @@ namespace spss {
 			m_selectionEnd = 0;
 			return;
 		}
-		else if (d > m_text.getString().getSize()) {
-			m_selectionEnd = m_text.getString().getSize();
+		else if (d > m_buffer.size()) {
+			m_selectionEnd = m_buffer.size();
 			return;
 		}
 		m_selectionEnd += _a;
@@ -896,4 +1122,98 @@ namespace spss {
 		return textWidth >= boxWidth;
 	}
 
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::updateSuggestions() {
+		m_suggestionsNeedUpdate = false;
+		m_completionEnd         = m_selectionBegin;
+		clearSuggestions();
+
+		//Only a word directly before the caret is completed
+		if (sequenceSelected() || m_selectionBegin == 0 || m_buffer[m_selectionBegin - 1] == ' ') {
+			return;
+		}
+
+		m_completionStart = posAtPreviousWord(m_selectionBegin);
+
+		std::basic_string<sf::Uint32> word;
+		m_buffer.copy(m_completionStart, m_selectionBegin - m_completionStart, std::back_inserter(word));
+
+		std::string prefix;
+		sf::Utf32::toUtf8(word.begin(), word.end(), std::back_inserter(prefix));
+
+		m_completionProvider->complete(prefix, m_maxSuggestions, m_suggestions);
+
+		if (m_suggestions.empty()) {
+			return;
+		}
+
+		//The dropdown is placed right below the word being completed
+		sf::Vector2f position{std::max(getCharacterPos(m_completionStart).x, m_rectangle.getPosition().x),
+		                      m_rectangle.getPosition().y + getHeight()};
+		float        rowHeight{getLineSpacing()};
+		float        width{0.F};
+
+		m_suggestionTexts.reserve(m_suggestions.size());
+		for (const auto& suggestion : m_suggestions) {
+			m_suggestionTexts.emplace_back(sf::String::fromUtf8(suggestion.begin(), suggestion.end()),
+			                               m_font,
+			                               m_charSize);
+
+			auto& text{m_suggestionTexts.back()};
+			text.setFillColor(m_textFillColor);
+			text.setPosition(position.x + SUGGESTION_PAD,
+			                 position.y + rowHeight * (m_suggestionTexts.size() - 1));
+			width = std::max(width, text.getLocalBounds().width);
+		}
+
+		width += 2 * SUGGESTION_PAD;
+
+		m_suggestionBox.setPosition(position);
+		m_suggestionBox.setSize({width, rowHeight * m_suggestions.size()});
+		m_suggestionHighlight.setSize({width, rowHeight});
+		m_suggestionHighlight.setPosition(position);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::clearSuggestions() {
+		m_suggestions.clear();
+		m_suggestionTexts.clear();
+		m_selectedSuggestion = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextEntryBox::acceptSuggestion() {
+		//The text may have been edited since the last update
+		if (m_suggestionsNeedUpdate || m_selectionBegin != m_completionEnd || sequenceSelected()) {
+			updateSuggestions();
+			if (m_suggestions.empty()) {
+				return;
+			}
+		}
+
+		const std::string& suggestion{m_suggestions[m_selectedSuggestion]};
+
+		std::basic_string<sf::Uint32> inserted;
+		sf::Utf8::toUtf32(suggestion.begin(), suggestion.end(), std::back_inserter(inserted));
+
+		size_t count{m_selectionBegin - m_completionStart};
+		if (m_buffer.size() - count + inserted.size() > m_maxChars) {
+			return;
+		}
+
+		std::basic_string<sf::Uint32> removed;
+		m_buffer.copy(m_completionStart, count, std::back_inserter(removed));
+
+		m_history.seal();
+		m_history.record(m_completionStart, std::move(removed), inserted);
+		m_history.seal();
+		applyEdit(m_completionStart, count, inserted);
+
+		//The word is now complete, so there's nothing left to
+		//suggest until the user types again
+		m_suggestionsNeedUpdate = false;
+		m_completionEnd         = m_selectionBegin;
+		clearSuggestions();
+	}
+
 } //namespace spss
@@ -0,0 +1,70 @@
+#include <SPSS/Graphics/TextVertices.h>
+
+#include <SFML/Graphics/Font.hpp>
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	void appendTextVertices(sf::VertexArray& _vertices, const sf::Text& _text) {
+		const sf::Font* font{_text.getFont()};
+		if (font == nullptr || _text.getString().isEmpty()) {
+			return;
+		}
+
+		const sf::String& string{_text.getString()};
+		unsigned int      charSize{_text.getCharacterSize()};
+		float             outlineThickness{_text.getOutlineThickness()};
+		float             whitespaceWidth{font->getGlyph(L' ', charSize, false).advance};
+		float             lineSpacing{font->getLineSpacing(charSize)};
+		size_t            first{_vertices.getVertexCount()};
+
+		//sf::Text draws the whole outline below the whole fill, so
+		//the string is laid out twice
+		auto addGlyphs{[&](bool _outline) {
+			float      x{0.F};
+			float      y{float(charSize)};
+			sf::Uint32 previous{0};
+
+			for (auto c : string) {
+				x += font->getKerning(previous, c, charSize);
+				previous = c;
+
+				switch (c) {
+				case L' ':
+					x += whitespaceWidth;
+					continue;
+				case L'\t':
+					x += whitespaceWidth * 4;
+					continue;
+				case L'\n':
+					y += lineSpacing;
+					x = 0.F;
+					continue;
+				}
+
+				if (_outline) {
+					const sf::Glyph& glyph{font->getGlyph(c, charSize, false, outlineThickness)};
+					addGlyphQuad(_vertices, {x, y}, _text.getOutlineColor(), glyph, 0.F, outlineThickness);
+				}
+
+				const sf::Glyph& glyph{font->getGlyph(c, charSize, false)};
+				if (!_outline) {
+					addGlyphQuad(_vertices, {x, y}, _text.getFillColor(), glyph, 0.F);
+				}
+
+				x += glyph.advance;
+			}
+		}};
+
+		if (outlineThickness != 0) {
+			addGlyphs(true);
+		}
+		addGlyphs(false);
+
+		const sf::Transform& transform{_text.getTransform()};
+		for (size_t i{first}; i < _vertices.getVertexCount(); i++) {
+			_vertices[i].position = transform.transformPoint(_vertices[i].position);
+		}
+	}
+
+} //namespace spss
@@ -0,0 +1,141 @@
+#include <SPSS/Graphics/TileCache.h>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	TileCache::TileCache(unsigned int _tileHeight, size_t _maxTiles)
+	            : m_render{nullptr},
+	              m_tileHeight{std::max(_tileHeight, 1U)},
+	              m_maxTiles{_maxTiles},
+	              m_left{0},
+	              m_width{0},
+	              m_tiles{} {
+	}
+
+	////////////////////////////////////////////////////////////
+	void TileCache::setRenderer(Function<sf::RenderTarget&> _render) {
+		m_render = std::move(_render);
+		invalidate();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TileCache::invalidate() {
+		for (auto& [index, tile] : m_tiles) {
+			tile.dirty = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TileCache::invalidate(float _top, float _bottom) {
+		int first{int(std::floor(_top / m_tileHeight))};
+		int last{int(std::floor(_bottom / m_tileHeight))};
+
+		for (auto it{m_tiles.lower_bound(first)}; it != m_tiles.end() && it->first <= last; ++it) {
+			it->second.dirty = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TileCache::clear() {
+		m_tiles.clear();
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t TileCache::getTileCount() const {
+		return m_tiles.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TileCache::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+		if (m_render == nullptr) {
+			return;
+		}
+
+		const sf::View& view{target.getView()};
+		float           left{view.getCenter().x - view.getSize().x / 2};
+		float           top{view.getCenter().y - view.getSize().y / 2};
+
+		//The tiles span the whole width of the view, so they're
+		//no good once it changes
+		if (left != m_left || view.getSize().x != m_width) {
+			m_tiles.clear();
+			m_left  = left;
+			m_width = view.getSize().x;
+		}
+
+		int first{int(std::floor(top / m_tileHeight))};
+		int last{int(std::ceil((top + view.getSize().y) / m_tileHeight)) - 1};
+
+		//The tiles were rendered with regular alpha blending onto
+		//a transparent texture, so their colors are premultiplied
+		states.blendMode = sf::BlendMode{sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha};
+
+		for (int i{first}; i <= last; i++) {
+			const sf::RenderTexture* texture{prepareTile(i, first, last)};
+			if (texture == nullptr) {
+				m_tiles.clear();
+				m_render(target);
+				return;
+			}
+		}
+
+		for (int i{first}; i <= last; i++) {
+			sf::Sprite sprite{m_tiles.at(i).texture->getTexture()};
+			sprite.setPosition(m_left, float(i) * m_tileHeight);
+			target.draw(sprite, states);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::RenderTexture* TileCache::prepareTile(int _index, int _first, int _last) const {
+		auto it{m_tiles.find(_index)};
+
+		if (it == m_tiles.end()) {
+			Tile tile{nullptr, true};
+
+			//The tiles are sorted, so the one farthest from the view
+			//is either the first or the last. Its texture is reused,
+			//unless it's in view as well.
+			if (!m_tiles.empty() && m_tiles.size() >= m_maxTiles) {
+				auto front{m_tiles.begin()};
+				auto back{std::prev(m_tiles.end())};
+				auto farthest{_first - front->first >= back->first - _last ? front : back};
+
+				if (farthest->first < _first || farthest->first > _last) {
+					tile.texture = std::move(farthest->second.texture);
+					m_tiles.erase(farthest);
+				}
+			}
+
+			if (tile.texture == nullptr) {
+				tile.texture = std::make_unique<sf::RenderTexture>();
+				if (!tile.texture->create(unsigned(std::ceil(m_width)), m_tileHeight)) {
+					return nullptr;
+				}
+			}
+
+			it = m_tiles.emplace(_index, std::move(tile)).first;
+		}
+
+		Tile& tile{it->second};
+		if (tile.dirty) {
+			float top{float(_index) * m_tileHeight};
+			float width{float(tile.texture->getSize().x)};
+
+			tile.texture->setView(sf::View{sf::FloatRect{m_left, top, width, float(m_tileHeight)}});
+			tile.texture->clear(sf::Color::Transparent);
+			m_render(*tile.texture);
+			tile.texture->display();
+			tile.dirty = false;
+		}
+
+		return tile.texture.get();
+	}
+
+} //namespace spss
@@ -0,0 +1,475 @@
+#include <SPSS/Graphics/WidgetTree.h>
+
+#include <SPSS/System/InputSnapshot.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float GRID_CELL_SIZE{128.F};
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	WidgetTree::WidgetTree(sf::RenderWindow& _window)
+	            : m_window{_window},
+	              m_nodes{},
+	              m_freeNodes{},
+	              m_removed{},
+	              m_drawOrder{},
+	              m_unbounded{},
+	              m_grid{},
+	              m_orderDirty{false},
+	              m_focus{NO_NODE},
+	              m_captured{NO_NODE},
+	              m_hovered{NO_NODE} {
+		m_nodes.push_back(Node{nullptr, nullptr, NO_NODE, {}, {}, {}, {}, 0, true, true, true, false, false, false, false, false});
+	}
+
+	////////////////////////////////////////////////////////////
+	WidgetTree::NodeId WidgetTree::addGroup(const sf::Vector2f& _position, NodeId _parent) {
+		return addNode(nullptr, nullptr, _position, _parent);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::remove(NodeId _node) {
+		if (_node != ROOT && isAlive(_node)) {
+			m_removed.push_back(_node);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::setPosition(NodeId _node, const sf::Vector2f& _position) {
+		m_nodes[_node].position = _position;
+		invalidateLayout(_node);
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::Vector2f& WidgetTree::getPosition(NodeId _node) const {
+		return m_nodes[_node].position;
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::setVisible(NodeId _node, bool _visible) {
+		if (m_nodes[_node].visible != _visible) {
+			m_nodes[_node].visible = _visible;
+			m_orderDirty           = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::setAnimated(NodeId _node, bool _animated) {
+		m_nodes[_node].animated = _animated;
+		propagateDirty(_node);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::invalidateLayout(NodeId _node) {
+		m_nodes[_node].layoutDirty = true;
+		propagateDirty(_node);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::invalidatePaint(NodeId _node) {
+		m_nodes[_node].paintDirty = true;
+		propagateDirty(_node);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::setFocus(NodeId _node) {
+		m_focus = _node;
+	}
+
+	////////////////////////////////////////////////////////////
+	WidgetTree::NodeId WidgetTree::getFocus() const {
+		return m_focus;
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t WidgetTree::getNodeCount() const {
+		return m_nodes.size() - m_freeNodes.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::getInput(sf::Event& _e) {
+		if (m_orderDirty) {
+			rebuildOrder();
+		}
+
+		switch (_e.type) {
+		case sf::Event::MouseMoved: {
+			//The widget that was hovered gets the move as well, so
+			//that it can clear its highlights
+			NodeId target{m_captured != NO_NODE ? m_captured : findNodeUnderCursor()};
+			if (m_hovered != NO_NODE && m_hovered != target) {
+				dispatch(m_hovered, _e);
+			}
+			m_hovered = target;
+
+			dispatch(target, _e);
+			dispatchUnbounded(_e);
+			break;
+		}
+
+		case sf::Event::MouseButtonPressed: {
+			//The widget losing focus gets the press as well, so that
+			//it can deactivate itself
+			NodeId target{findNodeUnderCursor()};
+			if (m_focus != NO_NODE && m_focus != target) {
+				dispatch(m_focus, _e);
+			}
+			m_focus    = target;
+			m_captured = target;
+
+			dispatch(target, _e);
+			dispatchUnbounded(_e);
+			break;
+		}
+
+		//The release goes to whichever widget got the press, even
+		//if the cursor has left it since
+		case sf::Event::MouseButtonReleased:
+			dispatch(m_captured != NO_NODE ? m_captured : findNodeUnderCursor(), _e);
+			dispatchUnbounded(_e);
+			m_captured = NO_NODE;
+			break;
+
+		case sf::Event::MouseWheelScrolled:
+			dispatch(findNodeUnderCursor(), _e);
+			dispatchUnbounded(_e);
+			break;
+
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased:
+		case sf::Event::TextEntered:
+			dispatch(m_focus, _e);
+			break;
+
+		//Anything else (resizing, losing focus, ...) concerns every
+		//widget
+		default:
+			for (NodeId node : m_drawOrder) {
+				dispatch(node, _e);
+			}
+			break;
+		}
+
+		releaseRemoved();
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::update() {
+		//Widgets being interacted with are kept up to date
+		if (isAlive(m_focus)) {
+			invalidatePaint(m_focus);
+		}
+		if (isAlive(m_captured)) {
+			invalidatePaint(m_captured);
+		}
+
+		if (m_orderDirty) {
+			rebuildOrder();
+		}
+
+		updateNode(ROOT, false);
+		releaseRemoved();
+
+		//Nodes added during the update are drawn right away
+		if (m_orderDirty) {
+			rebuildOrder();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::draw(sf::RenderWindow& window, sf::RenderStates states) const {
+		const sf::View& view{window.getView()};
+		sf::FloatRect   viewBounds{view.getCenter() - view.getSize() / 2.F, view.getSize()};
+
+		for (NodeId id : m_drawOrder) {
+			const Node& node{m_nodes[id]};
+			if (node.indexed && !node.bounds.intersects(viewBounds)) {
+				continue;
+			}
+			node.ops->draw(node.widget, window, states);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	WidgetTree::NodeId WidgetTree::addNode(void*               _widget,
+	                                       const WidgetOps*    _ops,
+	                                       const sf::Vector2f& _position,
+	                                       NodeId              _parent) {
+		NodeId id{m_nodes.size()};
+		if (!m_freeNodes.empty()) {
+			id = m_freeNodes.back();
+			m_freeNodes.pop_back();
+		}
+		else {
+			m_nodes.emplace_back();
+		}
+
+		//Reusing the children's storage of a freed node
+		Node& node{m_nodes[id]};
+		node.children.clear();
+
+		node.widget        = _widget;
+		node.ops           = _ops;
+		node.parent        = _parent;
+		node.position      = _position;
+		node.worldPosition = {};
+		node.bounds        = {};
+		node.order         = 0;
+		node.alive         = true;
+		node.visible       = true;
+		node.shown         = false;
+		node.indexed       = false;
+		node.layoutDirty   = true;
+		node.paintDirty    = _widget != nullptr;
+		node.childDirty    = false;
+
+		//Widgets without bounds can't be told apart by the cursor,
+		//so they're kept updated at all times
+		node.animated = _ops != nullptr && _ops->getBounds == nullptr;
+		if (node.animated) {
+			m_unbounded.push_back(id);
+		}
+
+		m_nodes[_parent].children.push_back(id);
+		propagateDirty(id);
+		m_orderDirty = true;
+
+		return id;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool WidgetTree::isAlive(NodeId _node) const {
+		return _node < m_nodes.size() && m_nodes[_node].alive;
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::propagateDirty(NodeId _node) {
+		//Once an ancestor knows, so do all of its own ancestors
+		for (NodeId parent{m_nodes[_node].parent}; parent != NO_NODE && !m_nodes[parent].childDirty; parent = m_nodes[parent].parent) {
+			m_nodes[parent].childDirty = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::updateNode(NodeId _node, bool _layoutDirty) {
+		//Widgets may add nodes while they're being updated, so no
+		//reference to a node is held across calls to them
+		bool layoutDirty{_layoutDirty || m_nodes[_node].layoutDirty};
+		bool childDirty{m_nodes[_node].childDirty};
+
+		if (layoutDirty) {
+			Node&  node{m_nodes[_node]};
+			NodeId parent{node.parent};
+
+			node.worldPosition = node.position;
+			if (parent != NO_NODE) {
+				node.worldPosition += m_nodes[parent].worldPosition;
+			}
+			node.layoutDirty = false;
+
+			if (node.ops != nullptr && node.ops->setPosition != nullptr) {
+				node.ops->setPosition(node.widget, node.worldPosition);
+			}
+		}
+
+		//Hidden widgets keep their flag until they're shown
+		bool updated{false};
+		if (m_nodes[_node].ops != nullptr && m_nodes[_node].shown &&
+		    (m_nodes[_node].paintDirty || m_nodes[_node].animated)) {
+			m_nodes[_node].paintDirty = false;
+			m_nodes[_node].ops->update(m_nodes[_node].widget);
+			updated = true;
+		}
+
+		if ((layoutDirty || updated) && m_nodes[_node].ops != nullptr && m_nodes[_node].ops->getBounds != nullptr) {
+			index(_node);
+		}
+
+		m_nodes[_node].childDirty = false;
+		if (!layoutDirty && !childDirty) {
+			return;
+		}
+
+		bool stillDirty{false};
+		for (size_t i{0}; i < m_nodes[_node].children.size(); i++) {
+			NodeId child{m_nodes[_node].children[i]};
+			updateNode(child, layoutDirty);
+
+			const Node& node{m_nodes[child]};
+			stillDirty = stillDirty || node.paintDirty || node.animated || node.childDirty;
+		}
+		m_nodes[_node].childDirty = m_nodes[_node].childDirty || stillDirty;
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::rebuildOrder() {
+		m_orderDirty = false;
+		m_drawOrder.clear();
+
+		//Depth first, so that children are drawn above their parents
+		std::vector<NodeId> stack{ROOT};
+		while (!stack.empty()) {
+			NodeId id{stack.back()};
+			stack.pop_back();
+
+			Node&  node{m_nodes[id]};
+			NodeId parent{node.parent};
+			node.shown = node.visible && (parent == NO_NODE || m_nodes[parent].shown);
+
+			if (node.shown && node.widget != nullptr) {
+				node.order = m_drawOrder.size();
+				m_drawOrder.push_back(id);
+			}
+
+			stack.insert(stack.end(), node.children.rbegin(), node.children.rend());
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::dispatch(NodeId _node, sf::Event& _e) {
+		if (!isAlive(_node) || !m_nodes[_node].shown || m_nodes[_node].ops == nullptr) {
+			return;
+		}
+
+		invalidatePaint(_node);
+		m_nodes[_node].ops->getInput(m_nodes[_node].widget, _e);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::dispatchUnbounded(sf::Event& _e) {
+		for (size_t i{0}; i < m_unbounded.size(); i++) {
+			dispatch(m_unbounded[i], _e);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	WidgetTree::NodeId WidgetTree::findNodeUnderCursor() const {
+		auto mousePos{InputSnapshot::get_instance().getMousePosition(m_window, m_window.getView())};
+
+		auto cell{m_grid.find(cellKey(int(std::floor(mousePos.x / GRID_CELL_SIZE)),
+		                              int(std::floor(mousePos.y / GRID_CELL_SIZE))))};
+		if (cell == m_grid.end()) {
+			return NO_NODE;
+		}
+
+		NodeId front{NO_NODE};
+		for (NodeId id : cell->second) {
+			const Node& node{m_nodes[id]};
+			if (node.shown && node.bounds.contains(mousePos) &&
+			    (front == NO_NODE || node.order > m_nodes[front].order)) {
+				front = id;
+			}
+		}
+		return front;
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::index(NodeId _node) {
+		sf::FloatRect bounds{m_nodes[_node].ops->getBounds(m_nodes[_node].widget)};
+		if (m_nodes[_node].indexed && bounds == m_nodes[_node].bounds) {
+			return;
+		}
+
+		unindex(_node);
+		m_nodes[_node].bounds  = bounds;
+		m_nodes[_node].indexed = true;
+
+		int left{int(std::floor(bounds.left / GRID_CELL_SIZE))};
+		int top{int(std::floor(bounds.top / GRID_CELL_SIZE))};
+		int right{int(std::floor((bounds.left + bounds.width) / GRID_CELL_SIZE))};
+		int bottom{int(std::floor((bounds.top + bounds.height) / GRID_CELL_SIZE))};
+
+		for (int y{top}; y <= bottom; y++) {
+			for (int x{left}; x <= right; x++) {
+				m_grid[cellKey(x, y)].push_back(_node);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::unindex(NodeId _node) {
+		if (!m_nodes[_node].indexed) {
+			return;
+		}
+		m_nodes[_node].indexed = false;
+
+		const sf::FloatRect& bounds{m_nodes[_node].bounds};
+
+		int left{int(std::floor(bounds.left / GRID_CELL_SIZE))};
+		int top{int(std::floor(bounds.top / GRID_CELL_SIZE))};
+		int right{int(std::floor((bounds.left + bounds.width) / GRID_CELL_SIZE))};
+		int bottom{int(std::floor((bounds.top + bounds.height) / GRID_CELL_SIZE))};
+
+		for (int y{top}; y <= bottom; y++) {
+			for (int x{left}; x <= right; x++) {
+				auto cell{m_grid.find(cellKey(x, y))};
+				if (cell == m_grid.end()) {
+					continue;
+				}
+
+				auto& nodes{cell->second};
+				nodes.erase(std::remove(nodes.begin(), nodes.end(), _node), nodes.end());
+				if (nodes.empty()) {
+					m_grid.erase(cell);
+				}
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t WidgetTree::cellKey(int _x, int _y) {
+		return (std::uint64_t(std::uint32_t(_x)) << 32) | std::uint32_t(_y);
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::releaseRemoved() {
+		if (m_removed.empty()) {
+			return;
+		}
+
+		//Removing a node twice, or one whose ancestor was removed
+		//as well, only releases it once
+		for (size_t i{0}; i < m_removed.size(); i++) {
+			NodeId id{m_removed[i]};
+			if (!isAlive(id)) {
+				continue;
+			}
+
+			auto& siblings{m_nodes[m_nodes[id].parent].children};
+			siblings.erase(std::find(siblings.begin(), siblings.end(), id));
+			release(id);
+		}
+		m_removed.clear();
+
+		//The freed nodes mustn't be drawn
+		rebuildOrder();
+	}
+
+	////////////////////////////////////////////////////////////
+	void WidgetTree::release(NodeId _node) {
+		for (NodeId child : m_nodes[_node].children) {
+			release(child);
+		}
+
+		unindex(_node);
+		if (m_nodes[_node].ops != nullptr && m_nodes[_node].ops->getBounds == nullptr) {
+			m_unbounded.erase(std::find(m_unbounded.begin(), m_unbounded.end(), _node));
+		}
+
+		for (NodeId* id : {&m_focus, &m_captured, &m_hovered}) {
+			if (*id == _node) {
+				*id = NO_NODE;
+			}
+		}
+
+		Node& node{m_nodes[_node]};
+		node.alive  = false;
+		node.widget = nullptr;
+		node.ops    = nullptr;
+		m_freeNodes.push_back(_node);
+	}
+
+} //namespace spss
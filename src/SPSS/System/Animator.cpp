@@ -0,0 +1,343 @@
+#include <SPSS/System/Animator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+constexpr float PI{3.14159265F};
+
+//The elapsed time of repeating tracks never stops
+constexpr float NO_LIMIT{std::numeric_limits<float>::max()};
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween::Tween()
+	            : m_tracks{}, m_channels{0} {
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween::Tween(Tween&& _other) noexcept
+	            : m_tracks{_other.m_tracks}, m_channels{_other.m_channels} {
+		_other.m_channels = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween& Animator::Tween::operator=(Tween&& _other) noexcept {
+		if (this != &_other) {
+			reset();
+			m_tracks          = _other.m_tracks;
+			m_channels        = _other.m_channels;
+			_other.m_channels = 0;
+		}
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween::~Tween() {
+		reset();
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Animator::Tween::isActive() const {
+		return m_channels > 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Animator::Tween::finished() const {
+		if (!isActive()) {
+			return true;
+		}
+
+		const auto& animator{Animator::get_instance()};
+		size_t      index{animator.m_indices[m_tracks[0]]};
+		return animator.m_repeat[index] == Repeat::Once &&
+		       animator.m_elapsed[index] >= animator.m_duration[index];
+	}
+
+	////////////////////////////////////////////////////////////
+	void Animator::Tween::restart() {
+		setProgress(0.F);
+	}
+
+	////////////////////////////////////////////////////////////
+	void Animator::Tween::setProgress(float _progress) {
+		auto& animator{Animator::get_instance()};
+		for (size_t i{0}; i < m_channels; i++) {
+			size_t index{animator.m_indices[m_tracks[i]]};
+
+			float elapsed{wrapTime(_progress * animator.m_duration[index], animator.m_period[index], animator.m_limit[index])};
+			float t{ease(linearProgress(elapsed / animator.m_duration[index]),
+			             animator.m_linearWeight[index],
+			             animator.m_quadraticWeight[index],
+			             animator.m_quadInOutWeight[index],
+			             animator.m_sineInOutWeight[index])};
+
+			animator.m_elapsed[index] = elapsed;
+			animator.m_value[index]   = animator.m_from[index] + (animator.m_to[index] - animator.m_from[index]) * t;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	float Animator::Tween::getFloat() const {
+		if (!isActive()) {
+			return 0.F;
+		}
+
+		const auto& animator{Animator::get_instance()};
+		return animator.m_value[animator.m_indices[m_tracks[0]]];
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Vector2f Animator::Tween::getVector() const {
+		if (m_channels < 2) {
+			return {getFloat(), 0.F};
+		}
+
+		const auto& animator{Animator::get_instance()};
+		return {animator.m_value[animator.m_indices[m_tracks[0]]],
+		        animator.m_value[animator.m_indices[m_tracks[1]]]};
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Color Animator::Tween::getColor() const {
+		if (m_channels < 4) {
+			return sf::Color::Transparent;
+		}
+
+		const auto& animator{Animator::get_instance()};
+		sf::Uint8   components[4];
+
+		for (size_t i{0}; i < 4; i++) {
+			float value{animator.m_value[animator.m_indices[m_tracks[i]]]};
+			components[i] = sf::Uint8(std::clamp(std::round(value), 0.F, 255.F));
+		}
+
+		return {components[0], components[1], components[2], components[3]};
+	}
+
+	////////////////////////////////////////////////////////////
+	void Animator::Tween::reset() {
+		auto& animator{Animator::get_instance()};
+		for (size_t i{0}; i < m_channels; i++) {
+			animator.removeTrack(m_tracks[i]);
+		}
+		m_channels = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Animator()
+	            : m_elapsed{},
+	              m_duration{},
+	              m_period{},
+	              m_limit{},
+	              m_from{},
+	              m_to{},
+	              m_progress{},
+	              m_value{},
+	              m_linearWeight{},
+	              m_quadraticWeight{},
+	              m_quadInOutWeight{},
+	              m_sineInOutWeight{},
+	              m_repeat{},
+	              m_ids{},
+	              m_indices{},
+	              m_freeIds{} {
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween Animator::tween(float  _from,
+	                                float  _to,
+	                                float  _duration,
+	                                Easing _easing,
+	                                Repeat _repeat) {
+		return addTween(&_from, &_to, 1, _duration, _easing, _repeat);
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween Animator::tween(const sf::Vector2f& _from,
+	                                const sf::Vector2f& _to,
+	                                float               _duration,
+	                                Easing              _easing,
+	                                Repeat              _repeat) {
+		float from[]{_from.x, _from.y};
+		float to[]{_to.x, _to.y};
+		return addTween(from, to, 2, _duration, _easing, _repeat);
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween Animator::tween(const sf::Color& _from,
+	                                const sf::Color& _to,
+	                                float            _duration,
+	                                Easing           _easing,
+	                                Repeat           _repeat) {
+		float from[]{float(_from.r), float(_from.g), float(_from.b), float(_from.a)};
+		float to[]{float(_to.r), float(_to.g), float(_to.b), float(_to.a)};
+		return addTween(from, to, 4, _duration, _easing, _repeat);
+	}
+
+	////////////////////////////////////////////////////////////
+	void Animator::update(int _timeslice) {
+		const float  delta{float(_timeslice)};
+		const size_t count{m_elapsed.size()};
+
+		//The repeat modes and easing curves are per-track numbers
+		//rather than enums, so these loops are the same arithmetic
+		//for every track, without branches, and they vectorize
+		for (size_t i{0}; i < count; i++) {
+			m_elapsed[i]  = wrapTime(m_elapsed[i] + delta, m_period[i], m_limit[i]);
+			m_progress[i] = linearProgress(m_elapsed[i] / m_duration[i]);
+		}
+
+		for (size_t i{0}; i < count; i++) {
+			m_progress[i] = ease(m_progress[i], m_linearWeight[i], m_quadraticWeight[i], m_quadInOutWeight[i], m_sineInOutWeight[i]);
+		}
+
+		for (size_t i{0}; i < count; i++) {
+			m_value[i] = m_from[i] + (m_to[i] - m_from[i]) * m_progress[i];
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t Animator::getTrackCount() const {
+		return m_elapsed.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::Tween Animator::addTween(const float* _from,
+	                                   const float* _to,
+	                                   size_t       _channels,
+	                                   float        _duration,
+	                                   Easing       _easing,
+	                                   Repeat       _repeat) {
+		Tween tween;
+		for (size_t i{0}; i < _channels; i++) {
+			tween.m_tracks[i] = addTrack(_from[i], _to[i], _duration, _easing, _repeat);
+		}
+		tween.m_channels = _channels;
+		return tween;
+	}
+
+	////////////////////////////////////////////////////////////
+	size_t Animator::addTrack(float _from, float _to, float _duration, Easing _easing, Repeat _repeat) {
+		size_t id{m_indices.size()};
+		if (!m_freeIds.empty()) {
+			id = m_freeIds.back();
+			m_freeIds.pop_back();
+		}
+		else {
+			m_indices.push_back(0);
+		}
+
+		m_indices[id] = m_elapsed.size();
+
+		float         duration{std::max(_duration, 1.F)};
+		EasingWeights weights{getEasingWeights(_easing)};
+
+		//Once tracks stop at their end, loops wrap around every
+		//duration, and ping-pongs every two (one there, one back)
+		m_elapsed.push_back(0.F);
+		m_duration.push_back(duration);
+		m_period.push_back(_repeat == Repeat::Loop ? duration : 2 * duration);
+		m_limit.push_back(_repeat == Repeat::Once ? duration : NO_LIMIT);
+		m_from.push_back(_from);
+		m_to.push_back(_to);
+		m_progress.push_back(0.F);
+		m_value.push_back(_from);
+		m_linearWeight.push_back(weights.linear);
+		m_quadraticWeight.push_back(weights.quadratic);
+		m_quadInOutWeight.push_back(weights.quadInOut);
+		m_sineInOutWeight.push_back(weights.sineInOut);
+		m_repeat.push_back(_repeat);
+		m_ids.push_back(id);
+
+		return id;
+	}
+
+	////////////////////////////////////////////////////////////
+	void Animator::removeTrack(size_t _id) {
+		size_t index{m_indices[_id]};
+		size_t last{m_elapsed.size() - 1};
+
+		m_elapsed[index]         = m_elapsed[last];
+		m_duration[index]        = m_duration[last];
+		m_period[index]          = m_period[last];
+		m_limit[index]           = m_limit[last];
+		m_from[index]            = m_from[last];
+		m_to[index]              = m_to[last];
+		m_progress[index]        = m_progress[last];
+		m_value[index]           = m_value[last];
+		m_linearWeight[index]    = m_linearWeight[last];
+		m_quadraticWeight[index] = m_quadraticWeight[last];
+		m_quadInOutWeight[index] = m_quadInOutWeight[last];
+		m_sineInOutWeight[index] = m_sineInOutWeight[last];
+		m_repeat[index]          = m_repeat[last];
+		m_ids[index]             = m_ids[last];
+
+		m_indices[m_ids[index]] = index;
+
+		m_elapsed.pop_back();
+		m_duration.pop_back();
+		m_period.pop_back();
+		m_limit.pop_back();
+		m_from.pop_back();
+		m_to.pop_back();
+		m_progress.pop_back();
+		m_value.pop_back();
+		m_linearWeight.pop_back();
+		m_quadraticWeight.pop_back();
+		m_quadInOutWeight.pop_back();
+		m_sineInOutWeight.pop_back();
+		m_repeat.pop_back();
+		m_ids.pop_back();
+
+		m_freeIds.push_back(_id);
+	}
+
+	////////////////////////////////////////////////////////////
+	Animator::EasingWeights Animator::getEasingWeights(Easing _easing) {
+		switch (_easing) {
+		case Easing::QuadIn:
+			return {0.F, 1.F, 0.F, 0.F};
+		case Easing::QuadOut:
+			return {2.F, -1.F, 0.F, 0.F};
+		case Easing::QuadInOut:
+			return {0.F, 0.F, 1.F, 0.F};
+		case Easing::SineInOut:
+			return {0.F, 0.F, 0.F, 1.F};
+		default:
+			return {1.F, 0.F, 0.F, 0.F};
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	inline float Animator::wrapTime(float _elapsed, float _period, float _limit) {
+		float elapsed{std::min(std::max(_elapsed, 0.F), _limit)};
+
+		//The time is never negative, so truncating is flooring
+		return elapsed - _period * float(int(elapsed / _period));
+	}
+
+	////////////////////////////////////////////////////////////
+	inline float Animator::linearProgress(float _cycles) {
+		return 1.F - std::fabs(_cycles - 1.F);
+	}
+
+	////////////////////////////////////////////////////////////
+	inline float Animator::ease(float _t, float _linear, float _quadratic, float _quadInOut, float _sineInOut) {
+		//QuadInOut is 2t^2 up to t = 0.5, then 1 - 2(1-t)^2, which
+		//both come down to 0.5 + 2u - 2u|u| with u = t - 0.5
+		float u{_t - 0.5F};
+		float quadInOut{0.5F + 2.F * u - 2.F * u * std::fabs(u)};
+
+		//SineInOut is 0.5 + 0.5 sin(x) for x in [-pi/2, pi/2], where
+		//its Taylor series up to x^9 is within a few millionths
+		float x{PI * u};
+		float x2{x * x};
+		float sine{x * (1.F + x2 * (-1.F / 6 + x2 * (1.F / 120 + x2 * (-1.F / 5040 + x2 / 362880))))};
+		float sineInOut{0.5F + 0.5F * sine};
+
+		return _linear * _t + _quadratic * _t * _t + _quadInOut * quadInOut + _sineInOut * sineInOut;
+	}
+
+} //namespace spss
@@ -2,6 +2,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include "SPSS/System/Core.h"
+#include "SPSS/Graphics/MulticolorText.h"
 
 namespace spss {
 
@@ -16,6 +17,8 @@ namespace spss {
 		int       simulationTime{0}; //as milliseconds
 		sf::Clock timesliceClock{};
 
+		InputSnapshot::get_instance().sync(m_window);
+
 		while (m_window.isOpen() && !m_stateStack.empty()) {
 			m_window.clear(sf::Color(0, 0, 0));
 			getInput();
@@ -25,15 +28,26 @@ namespace spss {
 				update(m_timeslice);
 			}
 			draw();
+
+			//Callbacks may push or pop states, so they're run
+			//between frames
+			TaskPool::get_instance().runContinuations();
 		}
+
+		//A state may have closed the window itself, in which case
+		//the shader is at least released before the statics are
+		//destroyed
+		MulticolorText::releaseEffectShader();
 	}
 
 	////////////////////////////////////////////////////////////
 	void Core::getInput() {
 		sf::Event event;
 		while (m_window.pollEvent(event)) {
+			InputSnapshot::get_instance().handleEvent(event);
+
 			if (event.type == sf::Event::Closed) {
-				m_window.close();
+				exit();
 			}
 			if (m_stateStack.size() > 1) {
 				int currIndex{0};
@@ -52,6 +66,8 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void Core::update(int _timeslice) {
+		Animator::get_instance().update(_timeslice);
+
 		if (m_stateStack.size() > 1) {
 			int currIndex{0};
 			int maxIndex{int(m_stateStack.size()) - 1};
@@ -101,6 +117,8 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void Core::exit() {
+		//Shaders have to go while the window's context is still there
+		MulticolorText::releaseEffectShader();
 		m_window.close();
 	}
 
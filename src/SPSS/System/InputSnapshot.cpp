@@ -0,0 +1,166 @@
+#include <SPSS/System/InputSnapshot.h>
+
+#include <algorithm>
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	InputSnapshot::InputSnapshot()
+	            : m_keys{},
+	              m_buttons{},
+	              m_control{false},
+	              m_shift{false},
+	              m_alt{false},
+	              m_mousePixel{},
+	              m_mappedPositions{},
+	              m_mappedCount{0},
+	              m_nextMapped{0} {
+	}
+
+	////////////////////////////////////////////////////////////
+	void InputSnapshot::handleEvent(const sf::Event& _event) {
+		switch (_event.type) {
+		case sf::Event::KeyPressed:
+		case sf::Event::KeyReleased: {
+			if (_event.key.code >= 0 && _event.key.code < sf::Keyboard::KeyCount) {
+				m_keys[_event.key.code] = _event.type == sf::Event::KeyPressed;
+			}
+
+			//The modifier flags are reported with every key event,
+			//so they stay right even if a modifier was pressed while
+			//the window didn't have focus
+			m_control = _event.key.control;
+			m_shift   = _event.key.shift;
+			m_alt     = _event.key.alt;
+			break;
+		}
+
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased: {
+			m_buttons[_event.mouseButton.button] = _event.type == sf::Event::MouseButtonPressed;
+			setMousePixel({_event.mouseButton.x, _event.mouseButton.y});
+			break;
+		}
+
+		case sf::Event::MouseMoved: {
+			setMousePixel({_event.mouseMove.x, _event.mouseMove.y});
+			break;
+		}
+
+		case sf::Event::MouseWheelMoved: {
+			setMousePixel({_event.mouseWheel.x, _event.mouseWheel.y});
+			break;
+		}
+
+		case sf::Event::MouseWheelScrolled: {
+			setMousePixel({_event.mouseWheelScroll.x, _event.mouseWheelScroll.y});
+			break;
+		}
+
+		//Releases that happen while the window doesn't have focus
+		//are never reported, so nothing can be assumed to be held
+		case sf::Event::LostFocus: {
+			m_keys.reset();
+			m_buttons.reset();
+			m_control = false;
+			m_shift   = false;
+			m_alt     = false;
+			break;
+		}
+
+		case sf::Event::Resized: {
+			m_mappedCount = 0;
+			m_nextMapped  = 0;
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void InputSnapshot::sync(const sf::Window& _window) {
+		setMousePixel(sf::Mouse::getPosition(_window));
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::isKeyPressed(sf::Keyboard::Key _key) const {
+		return _key >= 0 && _key < sf::Keyboard::KeyCount && m_keys[_key];
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::areKeysPressed(std::initializer_list<sf::Keyboard::Key> _keys) const {
+		for (auto key : _keys) {
+			if (!isKeyPressed(key)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::control() const {
+		return m_control;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::shift() const {
+		return m_shift;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::alt() const {
+		return m_alt;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool InputSnapshot::isButtonPressed(sf::Mouse::Button _button) const {
+		return _button >= 0 && _button < sf::Mouse::ButtonCount && m_buttons[_button];
+	}
+
+	////////////////////////////////////////////////////////////
+	const sf::Vector2i& InputSnapshot::getMousePixel() const {
+		return m_mousePixel;
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::Vector2f InputSnapshot::getMousePosition(const sf::RenderTarget& _target,
+	                                             const sf::View&         _view) const {
+		//Only a handful of views are ever in use at once, so a
+		//linear search is the cheapest way to find the view
+		for (size_t i{0}; i < m_mappedCount; i++) {
+			const MappedPosition& mapped{m_mappedPositions[i]};
+			if (mapped.target == &_target &&
+			    mapped.center == _view.getCenter() &&
+			    mapped.size == _view.getSize() &&
+			    mapped.rotation == _view.getRotation() &&
+			    mapped.viewport == _view.getViewport()) {
+				return mapped.position;
+			}
+		}
+
+		//Once full, the entries are overwritten oldest first
+		MappedPosition& mapped{m_mappedPositions[m_nextMapped]};
+		mapped = {&_target,
+		          _view.getCenter(),
+		          _view.getSize(),
+		          _view.getRotation(),
+		          _view.getViewport(),
+		          _target.mapPixelToCoords(m_mousePixel, _view)};
+
+		m_mappedCount = std::max(m_mappedCount, m_nextMapped + 1);
+		m_nextMapped  = (m_nextMapped + 1) % MAPPED_POSITION_CAPACITY;
+		return mapped.position;
+	}
+
+	////////////////////////////////////////////////////////////
+	void InputSnapshot::setMousePixel(const sf::Vector2i& _pixel) {
+		if (_pixel != m_mousePixel) {
+			m_mousePixel  = _pixel;
+			m_mappedCount = 0;
+			m_nextMapped  = 0;
+		}
+	}
+
+} //namespace spss
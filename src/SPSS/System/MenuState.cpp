@@ -1,6 +1,18 @@
+#include <SPSS/Graphics/TextVertices.h>
+#include <SPSS/System/InputSnapshot.h>
 #include <SPSS/System/MenuState.h>
 
+#include <algorithm>
+#include <cmath>
+
 constexpr float SCROLLBAR_WIDTH{15};
+constexpr float HOVER_FADE_TIME{120.F};
+
+//Blend two colors, _t being how much of _to to use (0-1)
+sf::Color blendColors(const sf::Color& _from, const sf::Color& _to, float _t) {
+	auto blend{[_t](sf::Uint8 _a, sf::Uint8 _b) { return sf::Uint8(std::round(_a + (_b - _a) * _t)); }};
+	return {blend(_from.r, _to.r), blend(_from.g, _to.g), blend(_from.b, _to.b), blend(_from.a, _to.a)};
+}
 
 namespace spss {
 
@@ -12,6 +24,10 @@ namespace spss {
 
 	            : State{_w},
 	              m_font{_f},
+	              m_menuItems{},
+	              m_autoBounds{},
+	              m_manualBounds{},
+	              m_shortcuts{},
 	              m_view{sf::FloatRect(0,
 	                                   0,
 	                                   float(m_window.getSize().x),
@@ -20,15 +36,40 @@ namespace spss {
 	              m_titleText{},
 	              m_titleAutoPos{_titleAutoPos},
 	              m_scrollbar{&m_window, m_backgroundView, m_view},
-	              m_randomiseTextColor{false},
 	              m_randomColorDurationMS{500},
-	              m_scaleText{false},
 	              m_minScale{0.75},
 	              m_maxScale{1.25},
-	              m_rotateText{false},
 	              m_rotationDegrees{10},
+	              m_colorTimer{},
+	              m_rotationTween{},
+	              m_scaleTween{},
+	              m_random{std::random_device{}()},
 	              m_highlightColor{sf::Color::Yellow},
-	              m_highlightScale{1.0F} {
+	              m_highlightScale{1.0F},
+	              m_itemColor{sf::Color::White},
+	              m_hoveredItem{},
+	              m_busyItems{},
+	              m_fadingItems{},
+	              m_nextItemY{0.F},
+	              m_itemsWidth{0.F},
+	              m_records{},
+	              m_recordRows{},
+	              m_itemCharSize{34},
+	              m_recordsTop{0.F},
+	              m_recordHeight{0.F},
+	              m_recordsWidth{0.F},
+	              m_firstVisibleRecord{0},
+	              m_hoveredRecord{},
+	              m_onRecordsNearEnd{nullptr},
+	              m_recordPrefetchDistance{0.F},
+	              m_prefetchedRecordCount{NO_RECORD},
+	              m_itemVertices{sf::Triangles},
+	              m_manualVertices{sf::Triangles},
+	              m_rowVertices{sf::Triangles},
+	              m_itemVerticesNeedUpdate{true},
+	              m_rowVerticesNeedUpdate{true},
+	              m_itemCache{},
+	              m_scrollCaching{false} {
 		m_window.setView(m_view);
 		m_titleText.setFont(m_font);
 		m_titleText.setCharacterSize(64);
@@ -37,6 +78,13 @@ namespace spss {
 		m_titleText.setOrigin(m_titleText.getLocalBounds().width / 2,
 		                      m_titleText.getLocalBounds().height / 2);
 
+		//Records are only bound to rows while the view moves
+		m_scrollbar.setVisibleRangeCallback([this](float, float, float) { updateVisibleRecords(); });
+
+		m_itemCache.setRenderer([this](sf::RenderTarget& _target) {
+			_target.draw(m_itemVertices, sf::RenderStates{&m_font.getTexture(m_itemCharSize)});
+		});
+
 		onResize(m_window.getSize());
 	}
 
@@ -46,82 +94,90 @@ namespace spss {
 		m_scrollbar.getInput(_event);
 
 		if (lmbPressed(_event)) {
-			for (const auto& menuItem : m_menuItems) {
-				if (isMousedOver(menuItem) && !isFunctionNull(menuItem)) {
-					menuItem.boundFunction(std::any());
-					return;
-				}
+			if (auto index{findMousedOverItem()}) {
+				activateMenuItem(*index);
+				return;
+			}
+			if (auto record{findMousedOverRecord()}) {
+				m_records[*record].function();
+				return;
 			}
 		}
 
 		if (_event.type == sf::Event::KeyPressed) {
-			for (const auto& menuItem : m_menuItems) {
-				if (menuItem.keyCode == sf::Keyboard::Unknown) {
-					continue;
-				}
-
-				if (_event.key.code == menuItem.keyCode && !isFunctionNull(menuItem)) {
-					menuItem.boundFunction(std::any());
-					return;
-				}
+			auto it{m_shortcuts.find(_event.key.code)};
+			if (it != m_shortcuts.end()) {
+				activateMenuItem(it->second);
+				return;
 			}
 		}
 	}
 
 	////////////////////////////////////////////////////////////
-	void MenuState::update(int _timeslice) {
+	void MenuState::update(int /*_timeslice*/) {
+		updateBusyItems();
 		detectMouseClicks();
-		updateTitleText(_timeslice);
+		updateHoverFades();
+		updateTitleText();
 		m_scrollbar.update();
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::draw() const {
+		ensureGeometryUpdate();
+
+		//The menu items and records all use the same glyph texture
+		sf::RenderStates states{&m_font.getTexture(m_itemCharSize)};
+
 		m_window.setView(m_view);
-		for (const auto& menuItem : m_menuItems) {
-			if (!menuItem.manualPos) {
-				m_window.draw(menuItem.text);
-			}
+		if (m_scrollCaching) {
+			m_window.draw(m_itemCache);
 		}
+		else {
+			m_window.draw(m_itemVertices, states);
+		}
+		m_window.draw(m_rowVertices, states);
 
 		m_window.setView(m_backgroundView);
-		for (const auto& menuItem : m_menuItems) {
-			if (menuItem.manualPos) {
-				m_window.draw(menuItem.text);
-			}
-		}
+		m_window.draw(m_manualVertices, states);
 
 		m_window.draw(m_scrollbar);
 		m_window.draw(m_titleText);
 	}
 
 	////////////////////////////////////////////////////////////
-	void MenuState::addMenuItem(const std::string&       _string,
-	                            spss::Function<std::any> f,
-	                            int                      _keyCode) {
+	void MenuState::addMenuItem(const std::string& _string,
+	                            spss::Function<>   f,
+	                            int                _keyCode) {
 		sf::Text text;
 
 		text.setFont(m_font);
 		text.setOutlineThickness(1);
-		text.setCharacterSize(34);
+		text.setCharacterSize(m_itemCharSize);
 		text.setString(_string);
 		text.setOrigin(text.getLocalBounds().width / 2, 0);
 
 		m_menuItems.push_back({false, f, text, _keyCode, false});
+		applyItemStyle(m_menuItems.back());
 
-		onResize(m_window.getSize());
+		//The first clickable item bound to a key gets the shortcut
+		if (_keyCode != sf::Keyboard::Unknown && f != nullptr) {
+			m_shortcuts.emplace(_keyCode, m_menuItems.size() - 1);
+		}
+
+		layoutLastMenuItem();
 	}
 
 	////////////////////////////////////////////////////////////
-	void MenuState::addMenuItem(const std::string&       _string,
-	                            const sf::Vector2f&      _pos,
-	                            spss::Function<std::any> f,
-	                            int                      _keyCode) {
+	void MenuState::addMenuItem(const std::string&  _string,
+	                            const sf::Vector2f& _pos,
+	                            spss::Function<>    f,
+	                            int                 _keyCode) {
 		sf::Text text;
 
 		text.setFont(m_font);
 		text.setOutlineThickness(1);
-		text.setCharacterSize(34);
+		text.setCharacterSize(m_itemCharSize);
 		text.setString(_string);
 		text.setOrigin(text.getLocalBounds().width / 2, 0);
 
@@ -140,11 +196,24 @@ namespace spss {
 			ratioPos.y = 1;
 		}
 
-		//We don't need to set the text's actual position right away, since
-		//that will be handled later by adjustMenuItems()
-
 		m_menuItems.push_back({false, f, text, _keyCode, true, ratioPos});
-		onResize(m_window.getSize());
+		applyItemStyle(m_menuItems.back());
+
+		if (_keyCode != sf::Keyboard::Unknown && f != nullptr) {
+			m_shortcuts.emplace(_keyCode, m_menuItems.size() - 1);
+		}
+
+		layoutLastMenuItem();
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::addAsyncMenuItem(const std::string& _string,
+	                                 spss::Function<>   f,
+	                                 spss::Function<>   _onComplete,
+	                                 int                _keyCode) {
+		addMenuItem(_string, f, _keyCode);
+		m_menuItems.back().async      = true;
+		m_menuItems.back().onComplete = _onComplete;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -152,11 +221,66 @@ namespace spss {
 		addMenuItem("");
 	}
 
+	////////////////////////////////////////////////////////////
+	void MenuState::setMenuRecords(std::vector<MenuRecord> _records) {
+		m_records = std::move(_records);
+		m_hoveredRecord.reset();
+
+		m_recordsWidth = 0.F;
+		for (const auto& record : m_records) {
+			m_recordsWidth = std::max(m_recordsWidth, measureLabel(record.label));
+		}
+
+		updateLayout();
+
+		m_prefetchedRecordCount = NO_RECORD;
+		checkRecordPrefetch(m_scrollbar.getVisibleBottom() + m_recordPrefetchDistance);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::addMenuRecords(std::vector<MenuRecord> _records) {
+		for (auto& record : _records) {
+			m_recordsWidth = std::max(m_recordsWidth, measureLabel(record.label));
+			m_records.push_back(std::move(record));
+		}
+
+		//The records come after everything else, so nothing above
+		//them has to move
+		layoutRecords(m_nextItemY);
+		adjustFrame();
+
+		checkRecordPrefetch(m_scrollbar.getVisibleBottom() + m_recordPrefetchDistance);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::setRecordPrefetch(size_t _distance, Function<> _onNearEnd) {
+		m_onRecordsNearEnd       = std::move(_onNearEnd);
+		m_recordPrefetchDistance = _distance * 1.25F * m_font.getLineSpacing(m_itemCharSize);
+		m_prefetchedRecordCount  = NO_RECORD;
+
+		if (m_onRecordsNearEnd == nullptr) {
+			m_scrollbar.setPrefetchCallback(0.F, nullptr);
+			return;
+		}
+
+		m_scrollbar.setPrefetchCallback(m_recordPrefetchDistance,
+		                                [this](float, float _bottom) { checkRecordPrefetch(_bottom); });
+		checkRecordPrefetch(m_scrollbar.getVisibleBottom() + m_recordPrefetchDistance);
+	}
+
 	////////////////////////////////////////////////////////////
 	void MenuState::setScrollbarColor(sf::Color _c) {
 		m_scrollbar.setColor(_c);
 	}
 
+	////////////////////////////////////////////////////////////
+	void MenuState::setScrollCaching(bool _b) {
+		m_scrollCaching = _b;
+
+		//The tiles aren't kept up to date while caching is off
+		m_itemCache.clear();
+	}
+
 	////////////////////////////////////////////////////////////
 	void MenuState::resetViews(sf::Vector2u _newSize) {
 		m_view.reset(
@@ -180,41 +304,82 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void MenuState::adjustMenuItems() {
-		if (m_menuItems.empty()) {
+		m_nextItemY  = 0.F;
+		m_itemsWidth = 0.F;
+		m_autoBounds.clear();
+		m_manualBounds.clear();
+		m_itemVerticesNeedUpdate = true;
+
+		for (size_t i{0}; i < m_menuItems.size(); i++) {
+			layoutMenuItem(m_menuItems[i]);
+			indexMenuItem(i);
+		}
+
+		layoutRecords(m_nextItemY);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::layoutMenuItem(MenuItem& _menuItem) {
+		if (_menuItem.manualPos) {
+			//Manually positioned MenuItems will be handled
+			//seperately, and repositioned according to the
+			//ratio of the window size.
+			sf::Vector2f truePos{_menuItem.ratioPos};
+			truePos.x *= float(m_window.getSize().x);
+			truePos.y *= float(m_window.getSize().y);
+			_menuItem.text.setPosition(truePos);
 			return;
 		}
 
-		sf::Vector2f pos{m_view.getCenter().x, 0.F};
+		_menuItem.text.setPosition(m_view.getCenter().x, m_nextItemY);
+		m_nextItemY += 1.25F * m_font.getLineSpacing(_menuItem.text.getCharacterSize());
+		m_itemsWidth = std::max(m_itemsWidth, _menuItem.text.getLocalBounds().width);
+	}
 
-		auto it = m_menuItems.begin();
-		while (it != m_menuItems.end()) {
-			if ((*it).manualPos) {
-				//Manually positioned MenuItems will be handled
-				//seperately, and repositioned according to the
-				//ratio of the window size.
-				sf::Vector2f truePos{(*it).ratioPos};
-				truePos.x *= float(m_window.getSize().x);
-				truePos.y *= float(m_window.getSize().y);
-				(*it).text.setPosition(truePos);
-				++it;
-				continue;
-			}
+	////////////////////////////////////////////////////////////
+	void MenuState::layoutLastMenuItem() {
+		//The views are reset to fit the window, and moved back to
+		//where the scrollbar was once the frame has been adjusted
+		resetViews(m_window.getSize());
 
-			(*it).text.setPosition(pos);
-			pos.y += 1.25F * m_font.getLineSpacing((*it).text.getCharacterSize());
-			++it;
-		}
+		layoutMenuItem(m_menuItems.back());
+		indexMenuItem(m_menuItems.size() - 1);
+		appendItemVertices(m_menuItems.back());
+		layoutRecords(m_nextItemY);
+
+		adjustFrame();
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::adjustFrame() {
+		adjustViewport();
+		resetTitlePosition();
+		adjustBoundaries();
+		setupScrollbar();
+
+		//The records were laid out for the reset view, which the
+		//scrollbar may have moved since
+		updateVisibleRecords();
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateLayout() {
+		resetViews(m_window.getSize());
+		adjustMenuItems();
+		adjustFrame();
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::adjustBoundaries() {
-		if (m_menuItems.empty() || !m_titleAutoPos) {
+		if ((m_menuItems.empty() && m_records.empty()) || !m_titleAutoPos) {
 			return;
 		}
 
+		float lastY{m_records.empty() ? m_menuItems.back().text.getPosition().y
+		                              : m_recordsTop + m_recordHeight * (m_records.size() - 1)};
+
 		float upper{m_titleText.getPosition().y - m_titleText.getLocalBounds().height * 2};
-		float lower{m_view.getSize().y -
-		            (m_menuItems.back()).text.getPosition().y};
+		float lower{m_view.getSize().y - lastY};
 
 		lower -= upper;
 		lower -= 1.25F * m_font.getLineSpacing(m_titleText.getCharacterSize());
@@ -253,133 +418,477 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	void MenuState::detectMouseClicks() {
-		for (auto& menuItem : m_menuItems) {
-			//////////////////////////////////////////////////////////////
-			/// In order to avoid the menu items being rapidly detected
-			/// as moused over and then not moused over when the mouse is
-			/// near the edge, we'll set the scale to the default level
-			/// when detecting if it's moused over.
-			//////////////////////////////////////////////////////////////
-			menuItem.text.setScale({1.0F, 1.0F});
-
-			if (isMousedOver(menuItem) && !isFunctionNull(menuItem)) {
-				menuItem.mousedOver = true;
-				menuItem.text.setFillColor(m_highlightColor);
-				menuItem.text.setScale({m_highlightScale, m_highlightScale});
+		//Hit testing uses the items' unscaled bounds, so that they
+		//aren't rapidly detected as moused over and then not moused
+		//over when the mouse is near the edge
+		auto mousedOver{findMousedOverItem()};
+
+		if (mousedOver != m_hoveredItem) {
+			for (auto item : {m_hoveredItem, mousedOver}) {
+				if (!item) {
+					continue;
+				}
+
+				auto& menuItem{m_menuItems[*item]};
+				menuItem.mousedOver = item == mousedOver;
+				fadeHover(menuItem.hover, menuItem.mousedOver);
+
+				if (std::find(m_fadingItems.begin(), m_fadingItems.end(), *item) == m_fadingItems.end()) {
+					m_fadingItems.push_back(*item);
+				}
 			}
-			else {
-				menuItem.mousedOver = false;
-				if (menuItem.boundFunction == nullptr) {
-					//reduce the opacity of items that don't do anything
-					//when clicked on
-					sf::Color cFill{menuItem.text.getFillColor()};
-					cFill.a = 100;
-					menuItem.text.setFillColor(cFill);
-
-					sf::Color cOut{menuItem.text.getOutlineColor()};
-					cOut.a = 100;
-					menuItem.text.setOutlineColor(cOut);
+
+			m_hoveredItem = mousedOver;
+		}
+
+		//An item on top of a record takes the mouse
+		auto mousedOverRecord{mousedOver ? std::nullopt : findMousedOverRecord()};
+
+		if (mousedOverRecord != m_hoveredRecord) {
+			auto previousRecord{m_hoveredRecord};
+			m_hoveredRecord = mousedOverRecord;
+
+			for (auto record : {previousRecord, mousedOverRecord}) {
+				if (!record) {
+					continue;
 				}
-				else {
-					menuItem.text.setFillColor(sf::Color::White);
+
+				auto& row{m_recordRows[*record % m_recordRows.size()]};
+				if (row.record == *record) {
+					fadeHover(row.hover, record == m_hoveredRecord);
 				}
-				menuItem.text.setScale({1.0F, 1.0F});
 			}
 		}
 	}
 
 	////////////////////////////////////////////////////////////
-	void MenuState::updateTitleText(int _timeslice) {
-		float f_timeslice{float(_timeslice)};
-		//-------------------------------------------------
-		//randomize fill color every half second
-		if (m_randomiseTextColor) {
-			static sf::Clock clock;
-
-			if (clock.getElapsedTime().asMilliseconds() >= m_randomColorDurationMS) {
-				auto                               seed{std::chrono::high_resolution_clock::now().time_since_epoch().count()};
-				static std::mt19937                mt_rand(seed);
-				std::uniform_int_distribution<int> uniform_dist(0, 255);
-				int                                r{uniform_dist(mt_rand)};
-				int                                g{uniform_dist(mt_rand)};
-				int                                b{uniform_dist(mt_rand)};
-
-				int rx{uniform_dist(mt_rand)};
-				int gx{uniform_dist(mt_rand)};
-				int bx{uniform_dist(mt_rand)};
-
-				m_titleText.setFillColor(sf::Color(r, g, b));
-				m_titleText.setOutlineColor(sf::Color(rx, gx, bx));
-
-				clock.restart();
+	void MenuState::activateMenuItem(size_t _index) {
+		auto& menuItem{m_menuItems[_index]};
+
+		if (!menuItem.async) {
+			menuItem.boundFunction();
+			return;
+		}
+
+		if (menuItem.task.isPending()) {
+			return;
+		}
+
+		menuItem.task = TaskPool::get_instance().dispatch(menuItem.boundFunction, menuItem.onComplete);
+		m_busyItems.push_back(_index);
+		applyItemStyle(menuItem);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateBusyItems() {
+		for (size_t i{0}; i < m_busyItems.size();) {
+			auto& menuItem{m_menuItems[m_busyItems[i]]};
+			if (menuItem.task.isPending()) {
+				i++;
+				continue;
 			}
+
+			applyItemStyle(menuItem);
+			m_busyItems[i] = m_busyItems.back();
+			m_busyItems.pop_back();
 		}
-		//-------------------------------------------------
-		//Rotate the title text
-		if (m_rotateText) {
-			static bool rotatingLeft{false};
-			float       deltaRotation{0};
-			const float curRotation{m_titleText.getRotation()};
-
-			if (Util::Math::almostEqual(curRotation, m_rotationDegrees)) {
-				rotatingLeft = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateHoverFades() {
+		for (size_t i{0}; i < m_fadingItems.size();) {
+			auto& menuItem{m_menuItems[m_fadingItems[i]]};
+			if (menuItem.hover.finished()) {
+				menuItem.hover = Animator::Tween{};
+			}
+
+			applyItemStyle(menuItem);
+
+			if (menuItem.hover.isActive()) {
+				i++;
+				continue;
 			}
-			else if (Util::Math::almostEqual(curRotation, (360 - m_rotationDegrees))) {
-				rotatingLeft = false;
+
+			m_fadingItems[i] = m_fadingItems.back();
+			m_fadingItems.pop_back();
+		}
+
+		//There are only ever enough rows to cover the view
+		for (auto& row : m_recordRows) {
+			if (!row.hover.isActive()) {
+				continue;
 			}
 
-			if (rotatingLeft) {
-				deltaRotation = -1 * (f_timeslice / 1000.F);
+			if (row.hover.finished()) {
+				row.hover = Animator::Tween{};
 			}
-			else {
-				deltaRotation = (f_timeslice / 1000.F);
+
+			applyRowStyle(row);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::fadeHover(Animator::Tween& _hover, bool _hovered) {
+		float from{getHoverProgress(_hover, !_hovered)};
+		float to{_hovered ? 1.F : 0.F};
+
+		_hover = Animator::get_instance().tween(from, to, HOVER_FADE_TIME * std::abs(to - from),
+		                                        Animator::Easing::QuadOut);
+	}
+
+	////////////////////////////////////////////////////////////
+	float MenuState::getHoverProgress(const Animator::Tween& _hover, bool _hovered) {
+		if (_hover.isActive()) {
+			return _hover.getFloat();
+		}
+		return _hovered ? 1.F : 0.F;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::applyItemStyle(MenuItem& _menuItem) {
+		bool  busy{_menuItem.task.isPending()};
+		float hover{busy ? 0.F : getHoverProgress(_menuItem.hover, _menuItem.mousedOver)};
+
+		//reduce the opacity of items that don't do anything
+		//when clicked on, or are busy
+		sf::Color cFill{m_itemColor};
+		sf::Color cOut{_menuItem.text.getOutlineColor()};
+		if (busy || isFunctionNull(_menuItem)) {
+			cFill.a = 100;
+			cOut.a  = 100;
+		}
+		else {
+			cOut.a = 255;
+		}
+
+		float scale{1.0F + (m_highlightScale - 1.0F) * hover};
+
+		_menuItem.text.setFillColor(blendColors(cFill, m_highlightColor, hover));
+		_menuItem.text.setOutlineColor(cOut);
+		_menuItem.text.setScale({scale, scale});
+		updateItemVertices(_menuItem);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::ensureGeometryUpdate() const {
+		if (m_itemVerticesNeedUpdate) {
+			m_itemVertices.clear();
+			m_manualVertices.clear();
+			m_itemVerticesNeedUpdate = false;
+			m_itemCache.invalidate();
+
+			for (const auto& menuItem : m_menuItems) {
+				appendItemVertices(menuItem);
 			}
-			m_titleText.rotate(deltaRotation);
 		}
 
-		//-------------------------------------------------
-		//Scale the title text
-		if (m_scaleText) {
-			static sf::Vector2f minScale{m_minScale, m_minScale};
-			static sf::Vector2f maxScale{m_maxScale, m_maxScale};
-			static bool         scalingDown{false};
-			static sf::Vector2f deltaScale{1, 1};
-
-			if (maxScale.x <= deltaScale.x) {
-				scalingDown = true;
+		if (m_rowVerticesNeedUpdate) {
+			m_rowVertices.clear();
+			m_rowVerticesNeedUpdate = false;
+
+			for (const auto& row : m_recordRows) {
+				if (row.record != NO_RECORD) {
+					appendTextVertices(m_rowVertices, row.text);
+				}
 			}
-			else if (minScale.x >= deltaScale.x) {
-				scalingDown = false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::appendItemVertices(const MenuItem& _menuItem) const {
+		if (m_itemVerticesNeedUpdate) {
+			return;
+		}
+
+		auto& vertices{_menuItem.manualPos ? m_manualVertices : m_itemVertices};
+
+		_menuItem.firstVertex = vertices.getVertexCount();
+		appendTextVertices(vertices, _menuItem.text);
+		_menuItem.vertexCount = vertices.getVertexCount() - _menuItem.firstVertex;
+
+		if (!_menuItem.manualPos) {
+			invalidateItemTiles(_menuItem.firstVertex, _menuItem.vertexCount);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateItemVertices(const MenuItem& _menuItem) {
+		//Items being added are styled before they get any geometry
+		if (m_itemVerticesNeedUpdate || _menuItem.vertexCount == 0) {
+			return;
+		}
+
+		sf::VertexArray vertices{sf::Triangles};
+		appendTextVertices(vertices, _menuItem.text);
+
+		if (vertices.getVertexCount() != _menuItem.vertexCount) {
+			m_itemVerticesNeedUpdate = true;
+			return;
+		}
+
+		//Both the old and the new geometry have to be invalidated,
+		//since highlighting scales the item up
+		if (!_menuItem.manualPos) {
+			invalidateItemTiles(_menuItem.firstVertex, _menuItem.vertexCount);
+		}
+
+		auto& target{_menuItem.manualPos ? m_manualVertices : m_itemVertices};
+		for (size_t i{0}; i < _menuItem.vertexCount; i++) {
+			target[_menuItem.firstVertex + i] = vertices[i];
+		}
+
+		if (!_menuItem.manualPos) {
+			invalidateItemTiles(_menuItem.firstVertex, _menuItem.vertexCount);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::invalidateItemTiles(size_t _first, size_t _count) const {
+		if (!m_scrollCaching || _count == 0) {
+			return;
+		}
+
+		float top{m_itemVertices[_first].position.y};
+		float bottom{top};
+		for (size_t i{_first + 1}; i < _first + _count; i++) {
+			top    = std::min(top, m_itemVertices[i].position.y);
+			bottom = std::max(bottom, m_itemVertices[i].position.y);
+		}
+
+		m_itemCache.invalidate(top, bottom);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::layoutRecords(float _top) {
+		m_recordsTop   = _top;
+		m_recordHeight = 1.25F * m_font.getLineSpacing(m_itemCharSize);
+
+		//Enough rows to cover the view, plus the partially visible
+		//records at either edge
+		size_t rowCount{0};
+		if (!m_records.empty()) {
+			rowCount = std::min(m_records.size(),
+			                    size_t(std::ceil(m_view.getSize().y / m_recordHeight)) + 2);
+		}
+
+		m_recordRows.resize(rowCount);
+		for (auto& row : m_recordRows) {
+			row.record = NO_RECORD;
+			row.hover  = Animator::Tween{};
+			row.text.setFont(m_font);
+			row.text.setOutlineThickness(1);
+			row.text.setCharacterSize(m_itemCharSize);
+		}
+		m_rowVerticesNeedUpdate = true;
+
+		updateVisibleRecords(true);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateVisibleRecords(bool _force) {
+		if (m_recordRows.empty()) {
+			return;
+		}
+
+		float  viewTop{m_view.getCenter().y - m_view.getSize().y / 2};
+		size_t first{0};
+		if (viewTop > m_recordsTop) {
+			first = std::min(size_t((viewTop - m_recordsTop) / m_recordHeight), m_records.size() - 1);
+		}
+
+		if (!_force && first == m_firstVisibleRecord) {
+			return;
+		}
+
+		m_firstVisibleRecord = first;
+
+		size_t last{std::min(first + m_recordRows.size(), m_records.size())};
+		for (size_t i{first}; i < last; i++) {
+			auto& row{m_recordRows[i % m_recordRows.size()]};
+			if (row.record == i) {
+				continue;
 			}
 
-			if (scalingDown) {
-				deltaScale.x -= f_timeslice / 10000.F;
-				deltaScale.y -= f_timeslice / 10000.F;
+			const auto& label{m_records[i].label};
+
+			row.record = i;
+			row.hover  = Animator::Tween{};
+			row.text.setString(sf::String::fromUtf8(label.begin(), label.end()));
+			row.text.setOrigin(row.text.getLocalBounds().width / 2, 0);
+			row.text.setPosition(m_view.getCenter().x, m_recordsTop + m_recordHeight * i);
+			applyRowStyle(row);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::checkRecordPrefetch(float _bottom) {
+		//Nothing more is asked for until the last request is answered
+		if (m_onRecordsNearEnd == nullptr || m_prefetchedRecordCount == m_records.size()) {
+			return;
+		}
+
+		float recordsBottom{m_recordsTop + m_recordHeight * m_records.size()};
+		if (_bottom >= recordsBottom) {
+			m_prefetchedRecordCount = m_records.size();
+			m_onRecordsNearEnd();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::applyRowStyle(RecordRow& _row) {
+		m_rowVerticesNeedUpdate = true;
+
+		float hover{getHoverProgress(_row.hover, m_hoveredRecord == _row.record)};
+
+		//Rows are reused, so the outline has to be reset too
+		sf::Color cFill{m_itemColor};
+		sf::Color cOut{sf::Color::Black};
+		if (m_records[_row.record].function == nullptr) {
+			cFill.a = 100;
+			cOut.a  = 100;
+		}
+
+		float scale{1.0F + (m_highlightScale - 1.0F) * hover};
+
+		_row.text.setFillColor(blendColors(cFill, m_highlightColor, hover));
+		_row.text.setOutlineColor(cOut);
+		_row.text.setScale({scale, scale});
+	}
+
+	////////////////////////////////////////////////////////////
+	std::optional<size_t> MenuState::findMousedOverRecord() const {
+		if (m_recordRows.empty()) {
+			return std::nullopt;
+		}
+
+		auto pixelPos{InputSnapshot::get_instance().getMousePosition(m_window, m_view)};
+		if (pixelPos.y < m_recordsTop) {
+			return std::nullopt;
+		}
+
+		size_t index(size_t((pixelPos.y - m_recordsTop) / m_recordHeight));
+		if (index >= m_records.size() || m_records[index].function == nullptr) {
+			return std::nullopt;
+		}
+
+		const auto& row{m_recordRows[index % m_recordRows.size()]};
+		if (row.record != index || !getUnscaledBounds(row.text).contains(pixelPos)) {
+			return std::nullopt;
+		}
+
+		return index;
+	}
+
+	////////////////////////////////////////////////////////////
+	float MenuState::measureLabel(const std::string& _label) const {
+		float      width{0.F};
+		sf::Uint32 previous{0};
+
+		for (auto c : sf::String::fromUtf8(_label.begin(), _label.end())) {
+			width += m_font.getKerning(previous, c, m_itemCharSize);
+			width += m_font.getGlyph(c, m_itemCharSize, false, 1).advance;
+			previous = c;
+		}
+
+		return width;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MenuState::updateTitleText() {
+		//-------------------------------------------------
+		//Randomize the colors whenever the timer runs out
+		if (m_colorTimer.isActive() && m_colorTimer.finished()) {
+			std::uniform_int_distribution<int> uniform_dist(0, 255);
+			int                                r{uniform_dist(m_random)};
+			int                                g{uniform_dist(m_random)};
+			int                                b{uniform_dist(m_random)};
+
+			int rx{uniform_dist(m_random)};
+			int gx{uniform_dist(m_random)};
+			int bx{uniform_dist(m_random)};
+
+			m_titleText.setFillColor(sf::Color(r, g, b));
+			m_titleText.setOutlineColor(sf::Color(rx, gx, bx));
+
+			m_colorTimer.restart();
+		}
+		//-------------------------------------------------
+		//Rotate and scale the title text
+		if (m_rotationTween.isActive()) {
+			m_titleText.setRotation(m_rotationTween.getFloat());
+		}
+		if (m_scaleTween.isActive()) {
+			m_titleText.setScale(m_scaleTween.getFloat(), m_scaleTween.getFloat());
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::optional<size_t> MenuState::findMousedOverItem() const {
+		auto& input{InputSnapshot::get_instance()};
+
+		if (!m_manualBounds.empty()) {
+			auto pixelPos{input.getMousePosition(m_window, m_backgroundView)};
+			for (const auto& item : m_manualBounds) {
+				if (item.bounds.contains(pixelPos)) {
+					return item.index;
+				}
 			}
-			else {
-				deltaScale.x += f_timeslice / 10000.F;
-				deltaScale.y += f_timeslice / 10000.F;
+		}
+
+		if (m_autoBounds.empty()) {
+			return std::nullopt;
+		}
+
+		auto pixelPos{input.getMousePosition(m_window, m_view)};
+
+		//Skip every item that ends above the mouse, and then check
+		//the items that start above it
+		auto it{std::partition_point(m_autoBounds.begin(), m_autoBounds.end(),
+		                             [&](const ItemBounds& _item) {
+			                             return _item.maxBottom <= pixelPos.y;
+		                             })};
+
+		for (; it != m_autoBounds.end() && it->bounds.top <= pixelPos.y; ++it) {
+			if (it->bounds.contains(pixelPos)) {
+				return it->index;
 			}
-			m_titleText.setScale(deltaScale);
 		}
+
+		return std::nullopt;
 	}
 
 	////////////////////////////////////////////////////////////
-	bool MenuState::isMousedOver(const MenuItem& _menuItem) const {
-		sf::Vector2i mousePos = sf::Mouse::getPosition(m_window);
+	void MenuState::indexMenuItem(size_t _index) {
+		const auto& menuItem{m_menuItems[_index]};
+		if (isFunctionNull(menuItem)) {
+			return;
+		}
 
-		//For manually positioned MenuItems, we're going to check them
-		//against the background view, whereas we'll use the scroll view
-		//for all other MenuItems.
+		auto bounds{getUnscaledBounds(menuItem.text)};
 
-		sf::Vector2f pixelPos{};
-		if (_menuItem.manualPos) {
-			pixelPos = {m_window.mapPixelToCoords(mousePos, m_backgroundView)};
+		if (menuItem.manualPos) {
+			m_manualBounds.push_back({bounds, 0.F, _index});
+			return;
 		}
-		else {
-			pixelPos = {m_window.mapPixelToCoords(mousePos, m_view)};
+
+		//Auto-positioned items are laid out from top to bottom, so
+		//appending keeps m_autoBounds sorted
+		float maxBottom{bounds.top + bounds.height};
+		if (!m_autoBounds.empty()) {
+			maxBottom = std::max(maxBottom, m_autoBounds.back().maxBottom);
 		}
-		return _menuItem.text.getGlobalBounds().contains(pixelPos);
+
+		m_autoBounds.push_back({bounds, maxBottom, _index});
+	}
+
+	////////////////////////////////////////////////////////////
+	sf::FloatRect MenuState::getUnscaledBounds(const sf::Text& _text) const {
+		auto bounds{_text.getLocalBounds()};
+		auto offset{_text.getPosition() - _text.getOrigin()};
+
+		bounds.left += offset.x;
+		bounds.top += offset.y;
+		return bounds;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -413,34 +922,54 @@ namespace spss {
 	void MenuState::onResize(sf::Vector2u _newSize) {
 		State::onResize(_newSize);
 		resetViews(_newSize);
-		adjustViewport();
-		resetTitlePosition();
 		adjustMenuItems();
-		adjustBoundaries();
-		setupScrollbar();
+		adjustFrame();
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setRandomisedColors(bool _b, int _duration) {
-		m_randomiseTextColor    = _b;
 		m_randomColorDurationMS = _duration;
+		m_colorTimer            = _b ? Animator::get_instance().tween(0.F, 1.F, float(_duration))
+		                             : Animator::Tween{};
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setScalingText(bool _b, float _minScale, float _maxScale) {
-		m_scaleText = _b;
 		if (_minScale > 0 && _maxScale > _minScale) {
 			m_minScale = _minScale;
 			m_maxScale = _maxScale;
 		}
+
+		if (!_b) {
+			m_scaleTween = {};
+			return;
+		}
+
+		//Scale by 0.1 per second, starting upwards from 1
+		m_scaleTween = Animator::get_instance().tween(m_minScale, m_maxScale,
+		                                              (m_maxScale - m_minScale) * 10000.F,
+		                                              Animator::Easing::Linear,
+		                                              Animator::Repeat::PingPong);
+		m_scaleTween.setProgress(std::clamp((1.F - m_minScale) / (m_maxScale - m_minScale), 0.F, 1.F));
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setRotatingText(bool _b, float _rotationDegrees) {
-		m_rotateText = _b;
 		if (_rotationDegrees > 0) {
 			m_rotationDegrees = _rotationDegrees;
 		}
+
+		if (!_b) {
+			m_rotationTween = {};
+			return;
+		}
+
+		//Rotate by 1 degree per second, starting clockwise from 0
+		m_rotationTween = Animator::get_instance().tween(-m_rotationDegrees, m_rotationDegrees,
+		                                                 2 * m_rotationDegrees * 1000.F,
+		                                                 Animator::Easing::Linear,
+		                                                 Animator::Repeat::PingPong);
+		m_rotationTween.setProgress(0.5F);
 	}
 
 	////////////////////////////////////////////////////////////
@@ -464,24 +993,54 @@ namespace spss {
 		for (auto& item : m_menuItems) {
 			item.text.setCharacterSize(_size);
 		}
+
+		m_itemCharSize = _size;
+		m_recordsWidth = 0.F;
+		for (const auto& record : m_records) {
+			m_recordsWidth = std::max(m_recordsWidth, measureLabel(record.label));
+		}
+
+		updateLayout();
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setMenuItemsColor(sf::Color _color) {
+		m_itemColor = _color;
 		for (auto& item : m_menuItems) {
-			item.text.setFillColor(_color);
+			applyItemStyle(item);
+		}
+		for (auto& row : m_recordRows) {
+			if (row.record != NO_RECORD) {
+				applyRowStyle(row);
+			}
 		}
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setHighlightColor(sf::Color _color) {
 		m_highlightColor = _color;
+		if (m_hoveredItem) {
+			applyItemStyle(m_menuItems[*m_hoveredItem]);
+		}
+		for (auto& row : m_recordRows) {
+			if (row.record != NO_RECORD) {
+				applyRowStyle(row);
+			}
+		}
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setHighlightScale(float _f) {
 		if (_f > 0) {
 			m_highlightScale = _f;
+			if (m_hoveredItem) {
+				applyItemStyle(m_menuItems[*m_hoveredItem]);
+			}
+			for (auto& row : m_recordRows) {
+				if (row.record != NO_RECORD) {
+					applyRowStyle(row);
+				}
+			}
 		}
 	}
 
@@ -492,22 +1051,29 @@ namespace spss {
 
 	////////////////////////////////////////////////////////////
 	float MenuState::getMenuHeight() const {
-		if (m_menuItems.empty()) {
+		if (m_menuItems.empty() && m_records.empty()) {
 			return 0;
 		}
 
-		const sf::Text& firstText{m_menuItems[0].text};
+		float top{m_menuItems.empty() ? m_recordsTop : m_menuItems[0].text.getPosition().y};
+
+		//Records only have a text while they're in view, so we'll
+		//use the line spacing as the last one's height
+		if (!m_records.empty()) {
+			return m_recordsTop + m_recordHeight * (m_records.size() - 1) +
+			       m_font.getLineSpacing(m_itemCharSize) - top;
+		}
+
 		const sf::Text& lastText{m_menuItems.back().text};
 
 		//Since menuItems have a Y origin of 0, we'll add the last text's height
 
-		return (lastText.getPosition().y + lastText.getGlobalBounds().height) -
-		       firstText.getPosition().y;
+		return (lastText.getPosition().y + lastText.getGlobalBounds().height) - top;
 	}
 
 	////////////////////////////////////////////////////////////
 	void MenuState::setupScrollbar() {
-		if (m_menuItems.empty()) {
+		if (m_menuItems.empty() && m_records.empty()) {
 			m_scrollbar.setActive(false);
 			return;
 		}
@@ -521,17 +1087,12 @@ namespace spss {
 
 		float visibleHeight{m_window.getSize().y - getMenuOffset()};
 
-		//We'll find the widest text object so that we can position the
-		//scrollbar as close as possible without being obtrusive
-		sf::Text& widestText{m_menuItems[0].text};
-		for (auto& item : m_menuItems) {
-			if (item.text.getGlobalBounds().width > widestText.getGlobalBounds().width) {
-				widestText = item.text;
-			}
-		}
+		//We'll find the widest centered text so that we can position
+		//the scrollbar as close as possible without being obtrusive
+		float widestWidth{std::max(m_itemsWidth, m_recordsWidth)};
 
 		sf::Vector2f scrollbarSize{SCROLLBAR_WIDTH, visibleHeight};
-		sf::Vector2f scrollbarPosition{20 + widestText.getPosition().x + widestText.getGlobalBounds().width / 2,
+		sf::Vector2f scrollbarPosition{20 + m_view.getCenter().x + widestWidth / 2,
 		                               getMenuOffset() - 10};
 
 		//Adjust the ranges so that they don't leave excess empty space
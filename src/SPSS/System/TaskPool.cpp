@@ -0,0 +1,176 @@
+#include <SPSS/System/TaskPool.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace spss {
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task::Task()
+	            : m_state{nullptr} {
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task::Task(Task&& _other) noexcept
+	            : m_state{std::move(_other.m_state)} {
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task& TaskPool::Task::operator=(Task&& _other) noexcept {
+		if (this != &_other) {
+			if (m_state != nullptr) {
+				m_state->detached = true;
+			}
+			m_state = std::move(_other.m_state);
+		}
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task::~Task() {
+		if (m_state != nullptr) {
+			m_state->detached = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TaskPool::Task::isPending() const {
+		return m_state != nullptr && !m_state->finished;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::exception_ptr TaskPool::Task::getError() const {
+		if (isPending() || m_state == nullptr) {
+			return nullptr;
+		}
+		return m_state->error;
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::TaskPool()
+	            : m_threads{},
+	              m_queue{},
+	              m_completed{},
+	              m_mutex{},
+	              m_condition{},
+	              m_stopping{false} {
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::~TaskPool() {
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+
+		for (auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task TaskPool::dispatch(Function<> _action, Function<> _onComplete) {
+		Task task;
+		task.m_state = std::make_shared<TaskState>(
+		  TaskState{std::move(_action), std::move(_onComplete), nullptr, nullptr, false, false});
+
+		queue(task.m_state);
+		return task;
+	}
+
+	////////////////////////////////////////////////////////////
+	TaskPool::Task TaskPool::dispatch(Function<> _action, Function<std::exception_ptr> _onResult) {
+		Task task;
+		task.m_state = std::make_shared<TaskState>(
+		  TaskState{std::move(_action), nullptr, std::move(_onResult), nullptr, false, false});
+
+		queue(task.m_state);
+		return task;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TaskPool::queue(const std::shared_ptr<TaskState>& _state) {
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+
+			//Leave a core for the main thread
+			if (m_threads.empty()) {
+				size_t threadCount{std::max(2U, std::thread::hardware_concurrency()) - 1};
+				for (size_t i{0}; i < threadCount; i++) {
+					m_threads.emplace_back(&TaskPool::work, this);
+				}
+			}
+
+			m_queue.push_back(_state);
+		}
+		m_condition.notify_one();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TaskPool::runContinuations() {
+		std::vector<std::shared_ptr<TaskState>> completed;
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			completed.swap(m_completed);
+		}
+
+		//A callback may dispatch further actions, so the lock
+		//mustn't be held while running them
+		for (size_t i{0}; i < completed.size(); i++) {
+			TaskState& state{*completed[i]};
+			state.finished = true;
+			if (state.detached) {
+				continue;
+			}
+
+			try {
+				if (state.onResult != nullptr) {
+					state.onResult(state.error);
+				}
+				else if (state.onComplete != nullptr) {
+					state.onComplete();
+				}
+			}
+			catch (...) {
+				//The remaining callbacks go back to the front of the
+				//queue, ahead of any actions that finished since
+				std::lock_guard<std::mutex> lock{m_mutex};
+				m_completed.insert(m_completed.begin(),
+				                   std::make_move_iterator(completed.begin() + i + 1),
+				                   std::make_move_iterator(completed.end()));
+				throw;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TaskPool::work() {
+		while (true) {
+			std::shared_ptr<TaskState> state;
+			{
+				std::unique_lock<std::mutex> lock{m_mutex};
+				m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+				//Whatever's still queued is finished before stopping
+				if (m_queue.empty()) {
+					return;
+				}
+
+				state = std::move(m_queue.front());
+				m_queue.pop_front();
+			}
+
+			try {
+				state->action();
+			}
+			catch (...) {
+				state->error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_completed.push_back(std::move(state));
+		}
+	}
+
+} //namespace spss